@@ -5,6 +5,8 @@
 
 #include <boost/concept_check.hpp>
 
+#include <type_traits>
+
 namespace perm_group {
 
 // rst: .. concept:: template<typename Alloc> Allocator
@@ -86,6 +88,25 @@ public:
 	const Alloc cAlloc;
 };
 
+// rst: Optionally, an allocator may support the expression `cAlloc.rebind_degree(m)`,
+// rst: returning an allocator of type `Alloc` for permutations of degree `m`.
+// rst: It is for example used by `generating_system` for working on a compressed domain.
+// rst:
+// rst: .. class:: template<typename Alloc> \
+// rst:            has_rebind_degree
+// rst:
+// rst:		A type derived from `std::true_type` if `cAlloc.rebind_degree(m)` is valid,
+// rst:		and otherwise derived from `std::false_type`.
+
+template<typename Alloc, typename = void>
+struct has_rebind_degree : std::false_type {
+};
+
+template<typename Alloc>
+struct has_rebind_degree<Alloc, detail::void_t<decltype(std::declval<const Alloc&>().rebind_degree(std::size_t()))> >
+: std::true_type {
+};
+
 } // namespace perm_group
 
 #endif /* PERM_GROUP_ALLOCATOR_ALLOCATOR_HPP */
\ No newline at end of file
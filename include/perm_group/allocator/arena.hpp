@@ -0,0 +1,335 @@
+#ifndef PERM_GROUP_ALLOCATOR_ARENA_HPP
+#define PERM_GROUP_ALLOCATOR_ARENA_HPP
+
+#include <perm_group/allocator/allocator.hpp>
+#include <perm_group/permutation/contiguous.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include <stdlib.h>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            arena_permutation
+// rst:
+// rst:		Models `MutablePermutation` and `DegreeAwarePermutation`, and has `contiguous_images`.
+// rst:
+// rst:		The permutation type of `arena_allocator`, which refers to a row of images in an arena.
+// rst:		It has value semantics: a copy constructed permutation owns its own array of images,
+// rst:		and assignment copies the images into the existing storage, which must have the same degree.
+// rst:		A permutation created outside the arena, e.g., by `make_perm`, owns its images.
+// rst:
+
+template<typename ValueType>
+struct arena_permutation {
+	using value_type = ValueType;
+public:
+
+	// rst:		.. function:: explicit arena_permutation(std::size_t n)
+	// rst:
+	// rst:			Construct a non-initialized permutation of degree `n` which owns its images.
+
+	explicit arena_permutation(std::size_t n) : owned(new value_type[n]), images(owned.get()), n(n) { }
+
+	arena_permutation(const arena_permutation &other) : arena_permutation(other.n) {
+		std::copy(other.images, other.images + n, images);
+	}
+
+	arena_permutation(arena_permutation &&other) : n(other.n) {
+		if(other.owned) {
+			owned = std::move(other.owned);
+			images = owned.get();
+			other.images = nullptr;
+			other.n = 0;
+		} else {
+			owned.reset(new value_type[n]);
+			images = owned.get();
+			std::copy(other.images, other.images + n, images);
+		}
+	}
+private:
+
+	// for the handles of the arena, which refer to a row without owning it
+	struct in_arena {
+	};
+public:
+
+	arena_permutation(in_arena, value_type *images, std::size_t n) : images(images), n(n) { }
+
+	arena_permutation &operator=(const arena_permutation &other) {
+		assert(n == other.n);
+		std::copy(other.images, other.images + n, images);
+		return *this;
+	}
+
+	arena_permutation &operator=(arena_permutation &&other) {
+		return *this = static_cast<const arena_permutation&> (other);
+	}
+
+	value_type get_(value_type i) const {
+		return images[i];
+	}
+
+	void put_(value_type i, value_type image) {
+		images[i] = image;
+	}
+
+	std::size_t degree_() const {
+		return n;
+	}
+
+	value_type *data_() {
+		return images;
+	}
+
+	const value_type *data_() const {
+		return images;
+	}
+
+	friend bool operator==(const arena_permutation &a, const arena_permutation &b) {
+		return a.n == b.n && std::equal(a.images, a.images + a.n, b.images);
+	}
+
+	friend bool operator!=(const arena_permutation &a, const arena_permutation &b) {
+		return !(a == b);
+	}
+private:
+	template<typename, typename>
+	friend struct arena_allocator;
+	std::unique_ptr<value_type[] > owned;
+	value_type *images;
+	std::size_t n;
+};
+
+// rst: .. class:: heap_slabs
+// rst:
+// rst:		The default slab provider for `arena_allocator`, which uses ``posix_memalign``.
+// rst:		A slab provider must have the following member functions.
+// rst:
+
+struct heap_slabs {
+	// rst:		.. function:: std::size_t round_size(std::size_t bytes) const
+	// rst:
+	// rst:			:returns: the size of the slab that will actually be allocated when requesting `bytes` bytes.
+
+	std::size_t round_size(std::size_t bytes) const {
+		return bytes;
+	}
+
+	// rst:		.. function:: void *allocate(std::size_t bytes)
+	// rst:
+	// rst:			:returns: a new slab of `bytes` bytes, which is a value returned by `round_size`.
+	// rst:				The slab must be aligned to 64 bytes, so the padded rows start on cache lines.
+
+	void *allocate(std::size_t bytes) {
+		void *p;
+		if(posix_memalign(&p, 64, bytes) != 0) throw std::bad_alloc();
+		return p;
+	}
+
+	// rst:		.. function:: void deallocate(void *p, std::size_t bytes)
+	// rst:
+	// rst:			Free a slab returned by `allocate`.
+
+	void deallocate(void *p, std::size_t bytes) {
+		std::free(p);
+	}
+};
+
+// rst: .. class:: template<typename ValueType, typename Slabs = heap_slabs> \
+// rst:            arena_allocator
+// rst:
+// rst:		An `Allocator` that stores the images of its permutations as fixed-stride rows of large contiguous slabs,
+// rst:		instead of allocating each permutation separately.
+// rst:		Permutations allocated after each other are therefore adjacent in memory,
+// rst:		and a transversal or a generating set can be scanned sequentially.
+// rst:		A copy of this allocator still refers to the same arena as the original,
+// rst:		and all memory is freed in bulk when the last copy is destructed.
+// rst:		Released permutations are reused by later allocations.
+// rst:		The allocator is not thread safe.
+// rst:		The slabs are allocated by a slab provider of type `Slabs`, see `heap_slabs`.
+// rst:
+
+template<typename ValueType, typename Slabs = heap_slabs>
+struct arena_allocator {
+	// rst:		.. type:: perm = arena_permutation<ValueType>
+	using perm = arena_permutation<ValueType>;
+	// rst:		.. type:: pointer = perm*
+	using pointer = perm*;
+	// rst:		.. type:: const_pointer = const perm*
+	using const_pointer = const perm*;
+	using value_type = ValueType;
+	static_assert(std::is_trivial<value_type>::value, "The images are stored in raw memory.");
+private:
+
+	struct Arena {
+		Arena(Slabs provider) : provider(std::move(provider)) { }
+
+		~Arena() {
+			for(value_type *slab : slabs)
+				provider.deallocate(slab, slab_bytes);
+		}
+	public:
+		Slabs provider;
+		std::size_t n, stride, slab_rows, slab_bytes;
+		std::vector<value_type*> slabs;
+		std::size_t next_row; // in the last slab
+		// the handles, which must have stable addresses as they are the pointers given to the user
+		std::deque<perm> rows;
+		// released handles, which may not have a row after compaction
+		std::vector<pointer> free_rows;
+	};
+public:
+
+	// rst:		.. function:: explicit arena_allocator(std::size_t n, std::size_t slab_bytes = 1 << 16, Slabs provider = Slabs())
+	// rst:
+	// rst:			Construct an allocator that allocates permutations of degree `n`,
+	// rst:			in slabs of roughly `slab_bytes` bytes, but with room for at least one permutation.
+	// rst:			Each row is padded to a multiple of 64 bytes, so rows do not share cache lines.
+
+	explicit arena_allocator(std::size_t n, std::size_t slab_bytes = 1 << 16, Slabs provider = Slabs())
+	: arena(std::make_shared<Arena>(std::move(provider))) {
+		constexpr std::size_t line = 64 / sizeof(value_type) > 0 ? 64 / sizeof(value_type) : 1;
+		arena->n = n;
+		arena->stride = std::max<std::size_t>(1, (n + line - 1) / line * line);
+		const std::size_t row_bytes = arena->stride * sizeof(value_type);
+		const std::size_t rows = std::max<std::size_t>(1, slab_bytes / row_bytes);
+		arena->slab_bytes = arena->provider.round_size(rows * row_bytes);
+		arena->slab_rows = arena->slab_bytes / row_bytes;
+		arena->next_row = arena->slab_rows;
+	}
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return arena->n;
+	}
+
+	// rst:		.. function:: arena_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`, with a new arena and a copy of the slab provider.
+
+	arena_allocator rebind_degree(std::size_t m) const {
+		return arena_allocator(m, arena->slab_bytes, arena->provider);
+	}
+
+	// rst:		.. function:: pointer make()
+
+	pointer make() {
+		if(!arena->free_rows.empty()) {
+			pointer p = arena->free_rows.back();
+			arena->free_rows.pop_back();
+			if(!p->images) p->images = new_row();
+			return p;
+		}
+		// the handle is constructed in place, as moving it would copy the images out of the arena
+		arena->rows.emplace_back(typename perm::in_arena(), new_row(), arena->n);
+		return &arena->rows.back();
+	}
+
+	// rst:		.. function:: pointer make_identity()
+
+	pointer make_identity() {
+		pointer p = make();
+		std::iota(p->images, p->images + arena->n, value_type());
+		return p;
+	}
+
+	// rst:		.. function:: template<typename UPerm> pointer copy(UPerm &&p)
+
+	template<typename UPerm>
+	pointer copy(UPerm &&other) {
+		pointer p = make();
+		copy_dispatch(p->images, other, has_contiguous_images<const typename std::remove_reference<UPerm>::type>());
+		return p;
+	}
+
+	// rst:		.. function:: void release(const_pointer p)
+
+	void release(const_pointer p) {
+		if(!p) return;
+		arena->free_rows.push_back(const_cast<pointer> (p));
+	}
+
+	// rst:		.. function:: std::size_t num_slabs() const
+	// rst:
+	// rst:			:returns: the number of slabs currently allocated.
+
+	std::size_t num_slabs() const {
+		return arena->slabs.size();
+	}
+
+	// rst:		.. function:: void compact()
+	// rst:
+	// rst:			Move the images of all permutations which have not been released into new slabs,
+	// rst:			without gaps and in the order the permutations were first allocated in,
+	// rst:			and free the old slabs.
+	// rst:			Pointers to permutations stay valid, but pointers into their image arrays are invalidated.
+	// rst:			Released permutations lose their rows, and get new rows when reused.
+
+	void compact() {
+		const std::unordered_set<const_pointer> isFree(arena->free_rows.begin(), arena->free_rows.end());
+		std::vector<value_type*> oldSlabs;
+		std::swap(oldSlabs, arena->slabs);
+		arena->next_row = arena->slab_rows;
+		for(std::size_t i = 0; i != arena->rows.size(); ++i) {
+			perm &p = arena->rows[i];
+			if(isFree.find(&p) != isFree.end()) {
+				p.images = nullptr;
+			} else {
+				value_type *row = new_row();
+				std::copy(p.images, p.images + arena->n, row);
+				p.images = row;
+			}
+		}
+		for(value_type *slab : oldSlabs)
+			arena->provider.deallocate(slab, arena->slab_bytes);
+	}
+
+	friend bool operator==(const arena_allocator &a, const arena_allocator &b) {
+		return a.arena == b.arena;
+	}
+
+	friend bool operator!=(const arena_allocator &a, const arena_allocator &b) {
+		return !(a == b);
+	}
+private:
+
+	value_type *new_row() {
+		if(arena->next_row == arena->slab_rows) {
+			arena->slabs.reserve(arena->slabs.size() + 1);
+			arena->slabs.push_back(static_cast<value_type*> (arena->provider.allocate(arena->slab_bytes)));
+			arena->next_row = 0;
+		}
+		return arena->slabs.back() + arena->stride * arena->next_row++;
+	}
+
+	template<typename Other>
+	void copy_dispatch(value_type *images, const Other &other, std::true_type) {
+		const auto *src = perm_group::contiguous_images(other);
+		std::copy(src, src + arena->n, images);
+	}
+
+	template<typename Other>
+	void copy_dispatch(value_type *images, const Other &other, std::false_type) {
+		for(std::size_t i = 0; i != arena->n; ++i)
+			images[i] = perm_group::get(other, i);
+	}
+private:
+	std::shared_ptr<Arena> arena;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_ARENA_HPP */
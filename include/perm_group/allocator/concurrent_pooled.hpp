@@ -0,0 +1,285 @@
+#ifndef PERM_GROUP_ALLOCATOR_CONCURRENT_POOLED_HPP
+#define PERM_GROUP_ALLOCATOR_CONCURRENT_POOLED_HPP
+
+#include <perm_group/allocator/allocator.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <boost/concept_check.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename Alloc> concurrent_pooled_allocator
+// rst:
+// rst:		An `Allocator` adaptor like `pooled_allocator`, but which may be used concurrently
+// rst:		by several threads, through the same object or through copies.
+// rst:		Each thread has its own pool of unused permutations, which it accesses without synchronization.
+// rst:		When a thread pool grows beyond its maximum size, half of it is moved as a batch
+// rst:		to a lock-free global list, from which threads with empty pools take batches again.
+// rst:		Batches beyond a maximum number of global permutations are released to the nested allocator.
+// rst:		When a thread exits, its pool is moved to the global list in the same way.
+// rst:		A copy of this allocator still refers to the same pools as the original,
+// rst:		and all pools are released when the last copy is destructed,
+// rst:		at which point no other thread may use the allocator.
+// rst:
+// rst:		The `make`, `make_identity`, `copy`, and `release` functions of `Alloc`
+// rst:		must be safe to call concurrently, as it is the case for `raw_ptr_allocator`
+// rst:		and `shared_ptr_allocator`.
+// rst:
+
+template<typename Alloc>
+struct concurrent_pooled_allocator {
+	// rst:		.. type:: perm = typename Alloc::perm
+	using perm = typename Alloc::perm;
+	BOOST_CONCEPT_ASSERT((boost::Assignable<perm>));
+	// rst:		.. type:: pointer = typename Alloc::pointer
+	using pointer = typename Alloc::pointer;
+	// rst:		.. type:: const_pointer = typename Alloc::const_pointer
+	using const_pointer = typename Alloc::const_pointer;
+private:
+
+	struct Batch {
+		Batch *next;
+		std::vector<pointer> perms;
+	};
+
+	struct Cache {
+		std::vector<pointer> perms;
+	};
+
+	struct State {
+		State(std::size_t pool_size, std::size_t global_size, Alloc alloc)
+		: id(next_id()), pool_size(pool_size), global_size(global_size), alloc(std::move(alloc)) { }
+
+		~State() {
+			for(Cache &c : caches)
+				for(pointer p : c.perms)
+					alloc.release(p);
+			Batch *b = global.load(std::memory_order_acquire);
+			while(b) {
+				for(pointer p : b->perms)
+					alloc.release(p);
+				Batch *next = b->next;
+				delete b;
+				b = next;
+			}
+		}
+
+		// move perms to the global list, or release them if it is full
+		void give_back(std::vector<pointer> perms) {
+			if(perms.empty()) return;
+			if(global_count.load(std::memory_order_relaxed) + perms.size() > global_size) {
+				for(pointer q : perms)
+					alloc.release(q);
+			} else {
+				global_count.fetch_add(perms.size(), std::memory_order_relaxed);
+				Batch *b = new Batch{nullptr, std::move(perms)};
+				push_batches(b, b);
+			}
+		}
+
+		void push_batches(Batch *first, Batch *last) {
+			Batch *head = global.load(std::memory_order_relaxed);
+			do {
+				last->next = head;
+			} while(!global.compare_exchange_weak(head, first,
+					std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		static std::uint64_t next_id() {
+			static std::atomic<std::uint64_t> counter(0);
+			return ++counter;
+		}
+	public:
+		const std::uint64_t id;
+		const std::size_t pool_size, global_size;
+		Alloc alloc;
+		std::atomic<Batch*> global{nullptr};
+		std::atomic<std::size_t> global_count{0};
+		std::mutex cachesMutex; // only for registering and unregistering a thread
+		std::list<Cache> caches; // stable addresses
+	};
+
+	// The caches of a thread, which are given back when the thread exits.
+	struct ThreadCaches {
+		struct Entry {
+			std::weak_ptr<State> state;
+			typename std::list<Cache>::iterator cache;
+		};
+	public:
+
+		~ThreadCaches() {
+			for(auto &e : entries) {
+				// if the allocator is gone, it has already released the cache
+				const std::shared_ptr<State> s = e.second.state.lock();
+				if(!s) continue;
+				std::vector<pointer> perms;
+				{
+					std::lock_guard<std::mutex> lock(s->cachesMutex);
+					perms = std::move(e.second.cache->perms);
+					s->caches.erase(e.second.cache);
+				}
+				s->give_back(std::move(perms));
+			}
+		}
+
+		void erase_expired() {
+			for(auto iter = entries.begin(); iter != entries.end();) {
+				if(iter->second.state.expired()) iter = entries.erase(iter);
+				else ++iter;
+			}
+		}
+	public:
+		std::unordered_map<std::uint64_t, Entry> entries;
+	};
+public:
+
+	// rst:		.. function:: explicit concurrent_pooled_allocator(std::size_t pool_size, Alloc alloc)
+	// rst:		              explicit concurrent_pooled_allocator(std::size_t pool_size, std::size_t global_size, Alloc alloc)
+	// rst:
+	// rst:			Construct an allocator with a given maximum pool size per thread,
+	// rst:			and a given maximum number of permutations in the global list, using the given nested allocator.
+	// rst:			The default global size is 8 times the pool size.
+
+	explicit concurrent_pooled_allocator(std::size_t pool_size, Alloc alloc)
+	: concurrent_pooled_allocator(pool_size, 8 * pool_size, std::move(alloc)) { }
+
+	explicit concurrent_pooled_allocator(std::size_t pool_size, std::size_t global_size, Alloc alloc)
+	: state(std::make_shared<State>(std::max<std::size_t>(pool_size, 1), global_size, std::move(alloc))) { }
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return state->alloc.degree();
+	}
+
+	// rst:		.. function:: concurrent_pooled_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			Requires `has_rebind_degree<Alloc>`.
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`, with new pools of the same maximum sizes.
+
+	template<typename A = Alloc, typename = typename std::enable_if<has_rebind_degree<A>::value>::type>
+	concurrent_pooled_allocator rebind_degree(std::size_t m) const {
+		return concurrent_pooled_allocator(state->pool_size, state->global_size, state->alloc.rebind_degree(m));
+	}
+
+	// rst:		.. function:: pointer make()
+
+	pointer make() {
+		pointer p = take();
+		return p ? p : state->alloc.make();
+	}
+
+	// rst:		.. function:: pointer make_identity()
+
+	pointer make_identity() {
+		pointer p = take();
+		if(!p) return state->alloc.make_identity();
+		for(std::size_t i = 0; i != degree(); ++i)
+			perm_group::put(*p, i, i);
+		return p;
+	}
+
+	// rst:		.. function:: template<typename UPerm> pointer copy(UPerm &&p)
+
+	template<typename UPerm>
+	pointer copy(UPerm &&other) {
+		pointer p = take();
+		if(!p) return state->alloc.copy(std::forward<UPerm>(other));
+		copy_dispatch(p, other,
+				std::is_same<perm,
+				/**/ typename std::remove_cv<
+				/*****/ typename std::remove_reference<UPerm>::type
+				/**/ >::type
+				> ());
+		return p;
+	}
+
+	// rst:		.. function:: void release(const_pointer p)
+
+	void release(const_pointer p) {
+		if(!p) return;
+		Cache &c = local_cache();
+		c.perms.push_back(const_cast<pointer> (p));
+		if(c.perms.size() <= state->pool_size) return;
+		// move the oldest half out
+		const std::size_t half = c.perms.size() / 2;
+		std::vector<pointer> out(c.perms.begin(), c.perms.begin() + half);
+		c.perms.erase(c.perms.begin(), c.perms.begin() + half);
+		state->give_back(std::move(out));
+	}
+private:
+
+	pointer take() {
+		Cache &c = local_cache();
+		if(c.perms.empty()) {
+			// take the whole list, which avoids the ABA problem of popping a single batch,
+			// keep the first batch and give the rest back
+			Batch *b = state->global.exchange(nullptr, std::memory_order_acquire);
+			if(!b) return pointer();
+			if(b->next) {
+				Batch *last = b->next;
+				while(last->next) last = last->next;
+				state->push_batches(b->next, last);
+			}
+			state->global_count.fetch_sub(b->perms.size(), std::memory_order_relaxed);
+			c.perms = std::move(b->perms);
+			delete b;
+			if(c.perms.empty()) return pointer();
+		}
+		pointer p = c.perms.back();
+		c.perms.pop_back();
+		return p;
+	}
+
+	Cache &local_cache() {
+		// the ids are never reused, so entries for destructed allocators are never found again
+		thread_local std::uint64_t lastId = 0;
+		thread_local Cache *lastCache = nullptr;
+		thread_local ThreadCaches caches;
+		if(lastId == state->id) return *lastCache;
+		auto iter = caches.entries.find(state->id);
+		if(iter == caches.entries.end()) {
+			// only keep entries for live allocators
+			caches.erase_expired();
+			typename std::list<Cache>::iterator cache;
+			{
+				std::lock_guard<std::mutex> lock(state->cachesMutex);
+				cache = state->caches.emplace(state->caches.end());
+			}
+			cache->perms.reserve(state->pool_size + 1);
+			iter = caches.entries.emplace(state->id, typename ThreadCaches::Entry{state, cache}).first;
+		}
+		lastId = state->id;
+		lastCache = &*iter->second.cache;
+		return *lastCache;
+	}
+
+	template<typename Other>
+	void copy_dispatch(pointer p, const Other &other, std::true_type) {
+		*p = other;
+	}
+
+	template<typename Other>
+	void copy_dispatch(pointer p, const Other &other, std::false_type) {
+		for(std::size_t i = 0; i != degree(); ++i)
+			perm_group::put(*p, i, perm_group::get(other, i));
+	}
+private:
+	std::shared_ptr<State> state;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_CONCURRENT_POOLED_HPP */
@@ -0,0 +1,266 @@
+#ifndef PERM_GROUP_ALLOCATOR_COUNTING_HPP
+#define PERM_GROUP_ALLOCATOR_COUNTING_HPP
+
+#include <perm_group/allocator/allocator.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace perm_group {
+
+// rst: .. class:: allocation_stats
+// rst:
+// rst:		Counters collected by `counting_allocator`.
+// rst:		The byte counts are estimates, assuming each permutation takes
+// rst:		``sizeof(perm)`` bytes plus the size of an image array of the degree.
+// rst:
+
+struct allocation_stats {
+	// rst:		.. var:: std::size_t makes
+	// rst:		         std::size_t make_identities
+	// rst:		         std::size_t copies
+	// rst:		         std::size_t releases
+	// rst:
+	// rst:			The number of calls to each function, where releases of null pointers are not counted.
+	// rst:		.. var:: std::size_t live
+	// rst:		         std::size_t peak_live
+	// rst:		         std::size_t live_bytes
+	// rst:		         std::size_t peak_bytes
+	// rst:
+	// rst:			The current and highest number of permutations that have been allocated and not released,
+	// rst:			and the memory of those.
+	// rst:		.. var:: std::size_t pool_hits
+	// rst:		         std::size_t pool_misses
+	// rst:
+	// rst:			If the nested allocator has `num_pooled`, e.g., `pooled_allocator`,
+	// rst:			the number of allocations through this allocator served from a pool or not,
+	// rst:			where an allocation is served from the pool when the pool was not empty.
+	std::size_t makes = 0, make_identities = 0, copies = 0, releases = 0;
+	std::size_t live = 0, peak_live = 0, live_bytes = 0, peak_bytes = 0;
+	std::size_t pool_hits = 0, pool_misses = 0;
+public:
+
+	// rst:		.. function:: friend std::ostream &operator<<(std::ostream &s, const allocation_stats &st)
+	// rst:
+	// rst:			Write a human readable report.
+
+	friend std::ostream &operator<<(std::ostream &s, const allocation_stats &st) {
+		s << "make:          " << st.makes << "\n"
+				<< "make_identity: " << st.make_identities << "\n"
+				<< "copy:          " << st.copies << "\n"
+				<< "release:       " << st.releases << "\n"
+				<< "live:          " << st.live << " (peak " << st.peak_live << ")\n"
+				<< "bytes:         " << st.live_bytes << " (peak " << st.peak_bytes << ")\n";
+		const std::size_t pool = st.pool_hits + st.pool_misses;
+		if(pool != 0)
+			s << "pool:          " << st.pool_hits << " hits, " << st.pool_misses << " misses ("
+			<< 100 * st.pool_hits / pool << "% hit rate)\n";
+		return s;
+	}
+};
+
+namespace detail {
+
+template<typename Alloc, typename = void>
+struct has_pool_stats : std::false_type {
+};
+
+template<typename Alloc>
+struct has_pool_stats<Alloc, void_t<decltype(std::declval<const Alloc&>().num_pooled())> >
+: std::true_type {
+};
+
+} // namespace detail
+
+// rst: .. class:: template<typename Alloc, bool Enabled = true> counting_allocator
+// rst:
+// rst:		An `Allocator` adaptor that counts the calls to the nested allocator in an `allocation_stats`.
+// rst:		A copy of this allocator, and an allocator from `rebind_degree`, share the counters with the original,
+// rst:		so the counters of a group, e.g., a `generating_system`, can be inspected through its allocator:
+// rst:		``std::cout << g.get_allocator().stats();``
+// rst:		The counting is not thread safe.
+// rst:
+// rst:		If `Enabled` is `false`, all calls are forwarded and nothing is counted,
+// rst:		so the type can be kept in the code and the counting can be disabled with a constant.
+// rst:
+
+template<typename Alloc, bool Enabled = true>
+struct counting_allocator {
+	// rst:		.. type:: perm = typename Alloc::perm
+	using perm = typename Alloc::perm;
+	// rst:		.. type:: pointer = typename Alloc::pointer
+	using pointer = typename Alloc::pointer;
+	// rst:		.. type:: const_pointer = typename Alloc::const_pointer
+	using const_pointer = typename Alloc::const_pointer;
+private:
+	using value_type = typename permutation_traits<perm>::value_type;
+	using HasPoolStats = detail::has_pool_stats<Alloc>;
+public:
+
+	// rst:		.. function:: explicit counting_allocator(Alloc alloc)
+	// rst:
+	// rst:			Construct an allocator using the given nested allocator, with new counters.
+
+	explicit counting_allocator(Alloc alloc) : alloc(std::move(alloc)), st(std::make_shared<allocation_stats>()) { }
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return alloc.degree();
+	}
+
+	// rst:		.. function:: counting_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			Requires `has_rebind_degree<Alloc>`.
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`, using the same counters.
+
+	template<typename A = Alloc, typename = typename std::enable_if<has_rebind_degree<A>::value>::type>
+	counting_allocator rebind_degree(std::size_t m) const {
+		return counting_allocator(alloc.rebind_degree(m), st);
+	}
+
+	// rst:		.. function:: pointer make()
+
+	pointer make() {
+		++st->makes;
+		return allocated([this]() {
+			return alloc.make();
+		});
+	}
+
+	// rst:		.. function:: pointer make_identity()
+
+	pointer make_identity() {
+		++st->make_identities;
+		return allocated([this]() {
+			return alloc.make_identity();
+		});
+	}
+
+	// rst:		.. function:: template<typename UPerm> pointer copy(UPerm &&p)
+
+	template<typename UPerm>
+	pointer copy(UPerm &&other) {
+		++st->copies;
+		return allocated([this, &other]() {
+			return alloc.copy(std::forward<UPerm>(other));
+		});
+	}
+
+	// rst:		.. function:: void release(const_pointer p)
+
+	void release(const_pointer p) {
+		if(!p) return;
+		++st->releases;
+		--st->live;
+		st->live_bytes -= bytes();
+		alloc.release(std::move(p));
+	}
+
+	// rst:		.. function:: const allocation_stats &stats() const
+
+	const allocation_stats &stats() const {
+		return *st;
+	}
+
+	// rst:		.. function:: void reset_stats()
+	// rst:
+	// rst:			Reset all counters, except the number of live permutations and their size,
+	// rst:			from which the peaks start again.
+
+	void reset_stats() {
+		allocation_stats fresh;
+		fresh.live = fresh.peak_live = st->live;
+		fresh.live_bytes = fresh.peak_bytes = st->live_bytes;
+		*st = fresh;
+	}
+private:
+
+	counting_allocator(Alloc alloc, std::shared_ptr<allocation_stats> st) : alloc(std::move(alloc)), st(std::move(st)) { }
+
+	std::size_t bytes() const {
+		return sizeof(perm) + degree() * sizeof(value_type);
+	}
+
+	template<typename F>
+	pointer allocated(F f) {
+		if(HasPoolStats::value) {
+			if(get_pooled(HasPoolStats()) != 0) ++st->pool_hits;
+			else ++st->pool_misses;
+		}
+		pointer p = f();
+		++st->live;
+		st->live_bytes += bytes();
+		st->peak_live = std::max(st->peak_live, st->live);
+		st->peak_bytes = std::max(st->peak_bytes, st->live_bytes);
+		return p;
+	}
+
+	std::size_t get_pooled(std::true_type) const {
+		return alloc.num_pooled();
+	}
+
+	std::size_t get_pooled(std::false_type) const {
+		return 0;
+	}
+private:
+	Alloc alloc;
+	std::shared_ptr<allocation_stats> st;
+};
+
+template<typename Alloc>
+struct counting_allocator<Alloc, false> {
+	using perm = typename Alloc::perm;
+	using pointer = typename Alloc::pointer;
+	using const_pointer = typename Alloc::const_pointer;
+public:
+
+	explicit counting_allocator(Alloc alloc) : alloc(std::move(alloc)) { }
+
+	std::size_t degree() const {
+		return alloc.degree();
+	}
+
+	template<typename A = Alloc, typename = typename std::enable_if<has_rebind_degree<A>::value>::type>
+	counting_allocator rebind_degree(std::size_t m) const {
+		return counting_allocator(alloc.rebind_degree(m));
+	}
+
+	pointer make() {
+		return alloc.make();
+	}
+
+	pointer make_identity() {
+		return alloc.make_identity();
+	}
+
+	template<typename UPerm>
+	pointer copy(UPerm &&other) {
+		return alloc.copy(std::forward<UPerm>(other));
+	}
+
+	void release(const_pointer p) {
+		alloc.release(std::move(p));
+	}
+
+	const allocation_stats &stats() const {
+		return st;
+	}
+
+	void reset_stats() { }
+private:
+	Alloc alloc;
+	static const allocation_stats st;
+};
+
+template<typename Alloc>
+const allocation_stats counting_allocator<Alloc, false>::st = allocation_stats();
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_COUNTING_HPP */
@@ -0,0 +1,204 @@
+#ifndef PERM_GROUP_ALLOCATOR_INTERNING_HPP
+#define PERM_GROUP_ALLOCATOR_INTERNING_HPP
+
+#include <perm_group/allocator/allocator.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename Alloc> interning_allocator
+// rst:
+// rst:		An `Allocator` adaptor that stores each distinct permutation returned by
+// rst:		`make_identity` and `copy` only once.
+// rst:		The permutations are hashed, and a request for a permutation equal to an existing one
+// rst:		returns a pointer to the existing one and increments its reference count.
+// rst:		Each `release` decrements the count, and the permutation is released to the nested allocator
+// rst:		when it reaches zero.
+// rst:		Permutations returned by `make_identity` and `copy` must therefore not be modified.
+// rst:		Permutations returned by `make` are not shared, as they are meant to be written to,
+// rst:		but they can be shared afterwards with `intern`.
+// rst:		A copy of this allocator still refers to the same table as the original.
+// rst:		The allocator is not thread safe.
+// rst:
+
+template<typename Alloc>
+struct interning_allocator {
+	// rst:		.. type:: perm = typename Alloc::perm
+	using perm = typename Alloc::perm;
+	// rst:		.. type:: pointer = typename Alloc::pointer
+	using pointer = typename Alloc::pointer;
+	// rst:		.. type:: const_pointer = typename Alloc::const_pointer
+	using const_pointer = typename Alloc::const_pointer;
+private:
+
+	struct Entry {
+		pointer p;
+		std::size_t hash, count;
+	};
+
+	struct Table {
+		Table(Alloc alloc) : alloc(std::move(alloc)) { }
+
+		~Table() {
+			for(auto &e : entries)
+				alloc.release(e.second.p);
+		}
+	public:
+		Alloc alloc;
+		std::unordered_map<const perm*, Entry> entries;
+		std::unordered_multimap<std::size_t, const perm*> byHash;
+	};
+public:
+
+	// rst:		.. function:: explicit interning_allocator(Alloc alloc)
+	// rst:
+	// rst:			Construct an allocator using the given nested allocator.
+
+	explicit interning_allocator(Alloc alloc) : table(std::make_shared<Table>(std::move(alloc))) { }
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return table->alloc.degree();
+	}
+
+	// rst:		.. function:: interning_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			Requires `has_rebind_degree<Alloc>`.
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`, with a new table.
+
+	template<typename A = Alloc, typename = typename std::enable_if<has_rebind_degree<A>::value>::type>
+	interning_allocator rebind_degree(std::size_t m) const {
+		return interning_allocator(table->alloc.rebind_degree(m));
+	}
+
+	// rst:		.. function:: pointer make()
+	// rst:
+	// rst:			:returns: a new permutation from the nested allocator, which is not shared.
+
+	pointer make() {
+		return table->alloc.make();
+	}
+
+	// rst:		.. function:: pointer make_identity()
+
+	pointer make_identity() {
+		const auto identity = [](std::size_t i) -> std::size_t {
+			return i;
+		};
+		return find_or_insert(identity, [this]() {
+			return table->alloc.make_identity();
+		});
+	}
+
+	// rst:		.. function:: template<typename UPerm> pointer copy(UPerm &&p)
+
+	template<typename UPerm>
+	pointer copy(UPerm &&other) {
+		const auto images = [&other](std::size_t i) -> std::size_t {
+			return perm_group::get(other, i);
+		};
+		return find_or_insert(images, [this, &other]() {
+			return table->alloc.copy(std::forward<UPerm>(other));
+		});
+	}
+
+	// rst:		.. function:: pointer intern(pointer p)
+	// rst:
+	// rst:			Share a permutation returned by `make`, after it has been written.
+	// rst:			If an equal permutation is already shared, `p` is released and the existing one is returned.
+	// rst:			Otherwise `p` becomes shared and is returned.
+
+	pointer intern(pointer p) {
+		const perm &cp = *p;
+		const auto images = [&cp](std::size_t i) -> std::size_t {
+			return perm_group::get(cp, i);
+		};
+		bool used = false;
+		pointer res = find_or_insert(images, [&]() {
+			used = true;
+			return p;
+		});
+		if(!used) table->alloc.release(p);
+		return res;
+	}
+
+	// rst:		.. function:: void release(const_pointer p)
+
+	void release(const_pointer p) {
+		if(!p) return;
+		auto iter = table->entries.find(&*p);
+		if(iter == table->entries.end()) {
+			table->alloc.release(std::move(p));
+			return;
+		}
+		Entry &e = iter->second;
+		if(--e.count != 0) return;
+		auto range = table->byHash.equal_range(e.hash);
+		for(auto it = range.first; it != range.second; ++it) {
+			if(it->second == iter->first) {
+				table->byHash.erase(it);
+				break;
+			}
+		}
+		pointer owned = std::move(e.p);
+		table->entries.erase(iter);
+		table->alloc.release(std::move(owned));
+	}
+
+	// rst:		.. function:: std::size_t num_shared() const
+	// rst:
+	// rst:			:returns: the number of distinct permutations currently shared.
+
+	std::size_t num_shared() const {
+		return table->entries.size();
+	}
+
+	// rst:		.. function:: std::size_t use_count(const_pointer p) const
+	// rst:
+	// rst:			:returns: the number of times the permutation has been handed out and not yet released,
+	// rst:				or 0 if it is not shared.
+
+	std::size_t use_count(const_pointer p) const {
+		const auto iter = table->entries.find(&*p);
+		return iter == table->entries.end() ? 0 : iter->second.count;
+	}
+private:
+
+	template<typename Images, typename Make>
+	pointer find_or_insert(Images images, Make make) {
+		const std::size_t n = degree();
+		std::size_t hash = n;
+		for(std::size_t i = 0; i != n; ++i)
+			hash ^= std::hash<std::size_t>()(images(i)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		auto range = table->byHash.equal_range(hash);
+		for(auto it = range.first; it != range.second; ++it) {
+			const perm &cand = *it->second;
+			bool equal = true;
+			for(std::size_t i = 0; i != n && equal; ++i)
+				equal = static_cast<std::size_t> (perm_group::get(cand, i)) == images(i);
+			if(!equal) continue;
+			Entry &e = table->entries.find(it->second)->second;
+			++e.count;
+			return e.p;
+		}
+		pointer p = make();
+		const perm *key = &*p;
+		table->entries.emplace(key, Entry{p, hash, 1});
+		table->byHash.emplace(hash, key);
+		return p;
+	}
+private:
+	std::shared_ptr<Table> table;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_INTERNING_HPP */
@@ -0,0 +1,186 @@
+#ifndef PERM_GROUP_ALLOCATOR_MMAP_HPP
+#define PERM_GROUP_ALLOCATOR_MMAP_HPP
+
+#include <perm_group/allocator/arena.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace perm_group {
+
+// rst: .. class:: mmap_slabs
+// rst:
+// rst:		A slab provider for `arena_allocator`, see `heap_slabs`, which maps each slab with ``mmap``.
+// rst:		Slabs can be backed by huge pages, to reduce TLB misses when accessing permutations of large degree,
+// rst:		in which case they are aligned to the huge page size,
+// rst:		and by a file, so the kernel can page out a chain that does not fit in memory.
+// rst:		A copy of a provider has the same options, but its own file.
+// rst:		Only available on POSIX systems.
+// rst:
+
+struct mmap_slabs {
+	// rst:		.. enum-class:: huge_pages
+	// rst:
+	// rst:			.. enumerator:: none
+	// rst:			.. enumerator:: transparent
+	// rst:
+	// rst:				Advise the kernel to use transparent huge pages with ``MADV_HUGEPAGE``.
+	// rst:			.. enumerator:: explicit_
+	// rst:
+	// rst:				Use ``MAP_HUGETLB``, falling back to transparent huge pages
+	// rst:				if no huge pages are reserved, or if the slabs are backed by a file.
+
+	enum class huge_pages {
+		none, transparent, explicit_
+	};
+
+	// rst:		.. class:: options
+	// rst:
+	// rst:			.. var:: huge_pages pages = huge_pages::transparent
+	// rst:			.. var:: bool populate = false
+	// rst:
+	// rst:				Use ``MAP_POPULATE`` to fault in each slab when it is mapped.
+	// rst:			.. var:: std::string file
+	// rst:
+	// rst:				If not empty, the slabs are mapped from a file created at this path.
+	// rst:				The file is unlinked right after it is created,
+	// rst:				and the disk space is given back when the provider is destructed.
+
+	struct options {
+		huge_pages pages = huge_pages::transparent;
+		bool populate = false;
+		std::string file;
+	};
+
+public:
+
+	// rst:		.. function:: mmap_slabs()
+	// rst:		              explicit mmap_slabs(options opts)
+
+	mmap_slabs() : mmap_slabs(options()) { }
+
+	explicit mmap_slabs(options opts) : opts(std::move(opts)) { }
+
+	mmap_slabs(const mmap_slabs &other) : opts(other.opts) { }
+
+	mmap_slabs(mmap_slabs &&other) : opts(std::move(other.opts)), fd(other.fd), file_size(other.file_size) {
+		other.fd = -1;
+	}
+
+	mmap_slabs &operator=(const mmap_slabs&) = delete;
+
+	~mmap_slabs() {
+		if(fd != -1) ::close(fd);
+	}
+
+	// rst:		.. function:: static constexpr std::size_t huge_page_size()
+	// rst:
+	// rst:			:returns: 2 MiB, the default huge page size on x86-64.
+
+	static constexpr std::size_t huge_page_size() {
+		return 2 << 20;
+	}
+
+	// rst:		.. function:: std::size_t round_size(std::size_t bytes) const
+	// rst:
+	// rst:			:returns: `bytes` rounded up to a multiple of the huge page size,
+	// rst:				or of the page size if huge pages are not used.
+
+	std::size_t round_size(std::size_t bytes) const {
+		const std::size_t unit = opts.pages == huge_pages::none
+				? static_cast<std::size_t> (::sysconf(_SC_PAGESIZE))
+				: huge_page_size();
+		return (bytes + unit - 1) / unit * unit;
+	}
+
+	// rst:		.. function:: void *allocate(std::size_t bytes)
+	// rst:
+	// rst:			:throws: `std::bad_alloc` if the slab can not be mapped.
+	// rst:			:throws: `std::system_error` if the backing file can not be created or extended.
+
+	void *allocate(std::size_t bytes) {
+		int flags = opts.populate ? MAP_POPULATE : 0;
+		void *p = MAP_FAILED;
+		if(opts.file.empty()) {
+			flags |= MAP_PRIVATE | MAP_ANONYMOUS;
+			if(opts.pages == huge_pages::explicit_)
+				p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+			if(p == MAP_FAILED)
+				p = map(bytes, flags, -1, 0);
+		} else {
+			if(fd == -1) open_file();
+			if(::ftruncate(fd, file_size + bytes) != 0)
+				throw std::system_error(errno, std::generic_category(), "Could not extend slab file '" + opts.file + "'.");
+			p = map(bytes, flags | MAP_SHARED, fd, file_size);
+			if(p != MAP_FAILED) file_size += bytes;
+		}
+		if(p == MAP_FAILED) throw std::bad_alloc();
+		if(opts.pages != huge_pages::none)
+			::madvise(p, bytes, MADV_HUGEPAGE); // only advice, so failure is fine
+		return p;
+	}
+
+	// rst:		.. function:: void deallocate(void *p, std::size_t bytes)
+	// rst:
+	// rst:			Unmaps the slab. The space in a backing file is not reused.
+
+	void deallocate(void *p, std::size_t bytes) {
+		::munmap(p, bytes);
+	}
+private:
+
+	// with huge pages the mapping is aligned to the huge page size, as the kernel can only back
+	// aligned huge pages, which a slab only mapped to page alignment would not contain
+	void *map(std::size_t bytes, int flags, int fd, off_t offset) const {
+		if(opts.pages == huge_pages::none)
+			return ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, fd, offset);
+		// reserve room for aligning, map the slab at the aligned address, and give back the rest
+		const std::size_t align = huge_page_size();
+		void *reserved = ::mmap(nullptr, bytes + align, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if(reserved == MAP_FAILED) return MAP_FAILED;
+		char *first = static_cast<char*> (reserved);
+		char *aligned = first + (align - reinterpret_cast<std::uintptr_t> (first) % align) % align;
+		void *p = ::mmap(aligned, bytes, PROT_READ | PROT_WRITE, flags | MAP_FIXED, fd, offset);
+		if(p == MAP_FAILED) {
+			::munmap(reserved, bytes + align);
+			return MAP_FAILED;
+		}
+		if(aligned != first) ::munmap(first, aligned - first);
+		char *last = first + bytes + align;
+		if(aligned + bytes != last) ::munmap(aligned + bytes, last - (aligned + bytes));
+		return p;
+	}
+
+	void open_file() {
+		fd = ::open(opts.file.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+		if(fd == -1)
+			throw std::system_error(errno, std::generic_category(), "Could not create slab file '" + opts.file + "'.");
+		::unlink(opts.file.c_str());
+	}
+private:
+	options opts;
+	int fd = -1;
+	std::size_t file_size = 0;
+};
+
+// rst: .. type:: template<typename ValueType> \
+// rst:           mmap_allocator = arena_allocator<ValueType, mmap_slabs>
+// rst:
+// rst:		An `arena_allocator` with slabs from `mmap_slabs`, e.g., constructed as
+// rst:		``mmap_allocator<int>(n, 1 << 21, mmap_slabs(opts))``.
+
+template<typename ValueType>
+using mmap_allocator = arena_allocator<ValueType, mmap_slabs>;
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_MMAP_HPP */
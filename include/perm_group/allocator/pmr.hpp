@@ -0,0 +1,164 @@
+#ifndef PERM_GROUP_ALLOCATOR_PMR_HPP
+#define PERM_GROUP_ALLOCATOR_PMR_HPP
+
+#include <perm_group/allocator/allocator.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#define PERM_GROUP_HAS_STD_PMR
+#endif
+#endif
+
+#ifdef PERM_GROUP_HAS_STD_PMR
+#include <memory_resource>
+#else
+#include <boost/container/pmr/memory_resource.hpp>
+#include <boost/container/pmr/polymorphic_allocator.hpp>
+#endif
+
+namespace perm_group {
+namespace pmr {
+
+// rst: .. type:: pmr::memory_resource
+// rst:           template<typename T> pmr::polymorphic_allocator
+// rst:
+// rst:		The ones from ``std::pmr`` when compiling with C++17 or later,
+// rst:		and otherwise the ones from ``boost::container::pmr``.
+
+#ifdef PERM_GROUP_HAS_STD_PMR
+using std::pmr::memory_resource;
+using std::pmr::polymorphic_allocator;
+#else
+using boost::container::pmr::memory_resource;
+using boost::container::pmr::polymorphic_allocator;
+#endif
+
+} // namespace pmr
+namespace detail {
+
+template<typename Perm, typename = void>
+struct is_pmr_aware : std::false_type {
+};
+
+template<typename Perm>
+struct is_pmr_aware<Perm, void_t<typename Perm::allocator_type> >
+: std::is_constructible<typename Perm::allocator_type, pmr::memory_resource*> {
+};
+
+} // namespace detail
+
+// rst: .. class:: template<typename Perm> pmr_allocator
+// rst:
+// rst:		An `Allocator` that places its permutations in a given `pmr::memory_resource`.
+// rst:		If `Perm` has an ``allocator_type`` that can be constructed from the resource,
+// rst:		e.g., ``std::vector<T, pmr::polymorphic_allocator<T>>``,
+// rst:		then the permutations are constructed with it, so their images are also taken from the resource.
+// rst:		Otherwise only the permutation objects themselves are placed in the resource.
+// rst:
+// rst:		The resource must outlive all permutations allocated from it.
+// rst:		A copy of this allocator uses the same resource.
+// rst:
+
+template<typename Perm>
+struct pmr_allocator {
+	// rst:		.. type:: perm = Perm
+	using perm = Perm;
+	// rst:		.. type:: pointer = perm*
+	using pointer = perm*;
+	// rst:		.. type:: const_pointer = const perm*
+	using const_pointer = const perm*;
+public:
+
+	// rst:		.. function:: pmr_allocator(std::size_t n, pmr::memory_resource *resource, bool destroy = true)
+	// rst:
+	// rst:			Construct an allocator that allocates permutations of degree `n` from `resource`.
+	// rst:			If `destroy` is `false`, then `release` does nothing,
+	// rst:			which is only valid if `perm` does not own memory outside the resource,
+	// rst:			and if the resource frees all its memory at once, e.g., a monotonic buffer.
+	// rst:			A whole group can then be discarded by destroying the resource,
+	// rst:			without visiting each permutation.
+
+	pmr_allocator(std::size_t n, pmr::memory_resource *resource, bool destroy = true)
+	: n(n), resource(resource), destroy(destroy) { }
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return n;
+	}
+
+	// rst:		.. function:: pmr::memory_resource *get_resource() const
+
+	pmr::memory_resource *get_resource() const {
+		return resource;
+	}
+
+	// rst:		.. function:: pmr_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`, with the same resource.
+
+	pmr_allocator rebind_degree(std::size_t m) const {
+		return pmr_allocator(m, resource, destroy);
+	}
+
+	// rst:		.. function:: pointer make()
+
+	pointer make() {
+		return construct(detail::is_pmr_aware<perm>());
+	}
+
+	// rst:		.. function:: pointer make_identity()
+
+	pointer make_identity() {
+		pointer p = make();
+		for(std::size_t i = 0; i != n; ++i)
+			perm_group::put(*p, i, i);
+		return p;
+	}
+
+	// rst:		.. function:: template<typename UPerm> pointer copy(UPerm &&p)
+
+	template<typename UPerm>
+	pointer copy(UPerm &&other) {
+		pointer p = make();
+		for(std::size_t i = 0; i != n; ++i)
+			perm_group::put(*p, i, perm_group::get(other, i));
+		return p;
+	}
+
+	// rst:		.. function:: void release(const_pointer p)
+	// rst:
+	// rst:			Destructs the permutation and gives its memory back to the resource,
+	// rst:			unless the allocator was constructed with `destroy` being `false`.
+
+	void release(const_pointer p) {
+		if(!p || !destroy) return;
+		p->~perm();
+		resource->deallocate(const_cast<pointer> (p), sizeof(perm), alignof(perm));
+	}
+private:
+
+	pointer construct(std::true_type) {
+		void *mem = resource->allocate(sizeof(perm), alignof(perm));
+		return new(mem) perm(n, typename perm::allocator_type(resource));
+	}
+
+	pointer construct(std::false_type) {
+		void *mem = resource->allocate(sizeof(perm), alignof(perm));
+		return new(mem) perm(perm_group::make_perm<perm>(n));
+	}
+private:
+	std::size_t n;
+	pmr::memory_resource *resource;
+	bool destroy;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_PMR_HPP */
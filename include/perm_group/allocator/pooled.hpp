@@ -58,6 +58,17 @@ public:
 		return alloc.degree();
 	}
 
+	// rst:		.. function:: pooled_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			Requires `has_rebind_degree<Alloc>`.
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`, with a new pool of the same maximum size.
+
+	template<typename A = Alloc, typename = typename std::enable_if<has_rebind_degree<A>::value>::type>
+	pooled_allocator rebind_degree(std::size_t m) const {
+		return pooled_allocator(pool_size, alloc.rebind_degree(m));
+	}
+
 	// rst:		.. function:: pointer make()
 
 	pointer make() {
@@ -112,6 +123,15 @@ public:
 		else
 			pool->push_back(const_cast<pointer> (p));
 	}
+
+	// rst:		.. function:: std::size_t num_pooled() const
+	// rst:
+	// rst:			:returns: the number of permutations currently in the pool,
+	// rst:				i.e., the next allocation is served from the pool if this is not 0.
+
+	std::size_t num_pooled() const {
+		return pool->size();
+	}
 private:
 
 	template<typename Other>
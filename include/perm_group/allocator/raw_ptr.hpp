@@ -33,6 +33,14 @@ public:
 		return n;
 	}
 
+	// rst:		.. function:: raw_ptr_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`.
+
+	raw_ptr_allocator rebind_degree(std::size_t m) const {
+		return raw_ptr_allocator(m);
+	}
+
 	// rst:		.. function:: pointer make()
 	// rst:
 	// rst:			:returns: `new perm(perm_group::make_perm<perm>(degree()))`
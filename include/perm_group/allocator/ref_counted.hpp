@@ -0,0 +1,232 @@
+#ifndef PERM_GROUP_ALLOCATOR_REF_COUNTED_HPP
+#define PERM_GROUP_ALLOCATOR_REF_COUNTED_HPP
+
+#include <perm_group/allocator/allocator.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace perm_group {
+namespace detail {
+
+template<typename Perm, bool Atomic>
+struct ref_counted_node {
+	using count_type = typename std::conditional<Atomic, std::atomic<std::size_t>, std::size_t>::type;
+public:
+
+	explicit ref_counted_node(Perm &&perm) : count(1), perm(std::move(perm)) { }
+
+	void inc() {
+		inc(std::integral_constant<bool, Atomic>());
+	}
+
+	bool dec() { // true if it was the last reference
+		return dec(std::integral_constant<bool, Atomic>());
+	}
+private:
+
+	void inc(std::false_type) {
+		++count;
+	}
+
+	void inc(std::true_type) {
+		count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool dec(std::false_type) {
+		return --count == 0;
+	}
+
+	bool dec(std::true_type) {
+		return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+	}
+public:
+	count_type count;
+	Perm perm;
+};
+
+} // namespace detail
+
+// rst: .. class:: template<typename T, typename Perm, bool Atomic> \
+// rst:            ref_counted_ptr
+// rst:
+// rst:		The pointer type of `ref_counted_allocator`, with `T` being either `Perm` or `const Perm`.
+// rst:		It is a single pointer to a node holding the reference count next to the permutation,
+// rst:		and otherwise behaves like `std::shared_ptr<T>`.
+// rst:		The count is updated with plain arithmetic, unless `Atomic` is `true`.
+// rst:		A pointer to `Perm` converts implicitly to a pointer to `const Perm`.
+// rst:
+
+template<typename T, typename Perm, bool Atomic>
+struct ref_counted_ptr {
+	using Node = detail::ref_counted_node<Perm, Atomic>;
+	// rst:		.. type:: element_type = T
+	using element_type = T;
+public:
+
+	ref_counted_ptr() = default;
+
+	ref_counted_ptr(std::nullptr_t) { }
+
+	ref_counted_ptr(const ref_counted_ptr &other) : node(other.node) {
+		if(node) node->inc();
+	}
+
+	ref_counted_ptr(ref_counted_ptr &&other) : node(other.node) {
+		other.node = nullptr;
+	}
+
+	template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+	ref_counted_ptr(const ref_counted_ptr<U, Perm, Atomic> &other) : node(other.node) {
+		if(node) node->inc();
+	}
+
+	template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+	ref_counted_ptr(ref_counted_ptr<U, Perm, Atomic> &&other) : node(other.node) {
+		other.node = nullptr;
+	}
+
+	~ref_counted_ptr() {
+		reset();
+	}
+
+	ref_counted_ptr &operator=(ref_counted_ptr other) {
+		std::swap(node, other.node);
+		return *this;
+	}
+
+	void reset() {
+		if(node && node->dec()) delete node;
+		node = nullptr;
+	}
+
+	T &operator*() const {
+		return node->perm;
+	}
+
+	T *operator->() const {
+		return &node->perm;
+	}
+
+	// rst:		.. function:: T *get() const
+
+	T *get() const {
+		return node ? &node->perm : nullptr;
+	}
+
+	// rst:		.. function:: std::size_t use_count() const
+	// rst:
+	// rst:			:returns: the number of pointers referring to the permutation, or 0 for a null pointer.
+
+	std::size_t use_count() const {
+		return node ? static_cast<std::size_t> (node->count) : 0;
+	}
+
+	explicit operator bool() const {
+		return node;
+	}
+
+	template<typename U>
+	friend bool operator==(const ref_counted_ptr &a, const ref_counted_ptr<U, Perm, Atomic> &b) {
+		return a.get() == b.get();
+	}
+
+	template<typename U>
+	friend bool operator!=(const ref_counted_ptr &a, const ref_counted_ptr<U, Perm, Atomic> &b) {
+		return a.get() != b.get();
+	}
+
+	friend bool operator==(const ref_counted_ptr &a, std::nullptr_t) {
+		return !a.node;
+	}
+
+	friend bool operator!=(const ref_counted_ptr &a, std::nullptr_t) {
+		return a.node;
+	}
+private:
+	template<typename, typename, bool>
+	friend struct ref_counted_ptr;
+	template<typename, bool>
+	friend struct ref_counted_allocator;
+
+	explicit ref_counted_ptr(Node *node) : node(node) { }
+private:
+	Node *node = nullptr;
+};
+
+// rst: .. class:: template<typename Perm, bool Atomic = false> \
+// rst:            ref_counted_allocator
+// rst:
+// rst:		An `Allocator` using reference-counting like `shared_ptr_allocator`,
+// rst:		but with intrusive counts and no control block.
+// rst:		With the default `Atomic = false` copies of pointers to the same permutation
+// rst:		may only be used by one thread at a time,
+// rst:		but copying and destroying pointers do not use atomic instructions.
+// rst:
+
+template<typename Perm, bool Atomic = false>
+struct ref_counted_allocator {
+	// rst:		.. type:: perm = Perm
+	using perm = Perm;
+	// rst:		.. type:: pointer = ref_counted_ptr<perm, perm, Atomic>
+	using pointer = ref_counted_ptr<perm, perm, Atomic>;
+	// rst:		.. type:: const_pointer = ref_counted_ptr<const perm, perm, Atomic>
+	using const_pointer = ref_counted_ptr<const perm, perm, Atomic>;
+private:
+	using Node = typename pointer::Node;
+public:
+
+	// rst:		.. function:: explicit ref_counted_allocator(std::size_t n)
+	// rst:
+	// rst:			Construct an allocator that allocates permutations of degree `n`.
+
+	explicit ref_counted_allocator(std::size_t n) : n(n) { }
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return n;
+	}
+
+	// rst:		.. function:: ref_counted_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`.
+
+	ref_counted_allocator rebind_degree(std::size_t m) const {
+		return ref_counted_allocator(m);
+	}
+
+	// rst:		.. function:: pointer make()
+
+	pointer make() {
+		return pointer(new Node(perm_group::make_perm<perm>(n)));
+	}
+
+	// rst:		.. function:: pointer make_identity()
+
+	pointer make_identity() {
+		return pointer(new Node(perm_group::make_identity_perm<perm>(n)));
+	}
+
+	// rst:		.. function:: template<typename UPerm> pointer copy(UPerm &&p)
+
+	template<typename UPerm>
+	pointer copy(UPerm &&p) {
+		return pointer(new Node(perm_group::copy_perm<perm>(n, std::forward<UPerm>(p))));
+	}
+
+	// rst:		.. function:: void release(const_pointer p)
+	// rst:
+	// rst:			Does nothing, the permutation is deleted when the last pointer to it is destructed.
+
+	void release(const_pointer p) { }
+private:
+	std::size_t n;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ALLOCATOR_REF_COUNTED_HPP */
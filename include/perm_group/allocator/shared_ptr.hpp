@@ -37,6 +37,14 @@ struct shared_ptr_allocator {
 		return n;
 	}
 
+	// rst:		.. function:: shared_ptr_allocator rebind_degree(std::size_t m) const
+	// rst:
+	// rst:			:returns: an allocator for permutations of degree `m`.
+
+	shared_ptr_allocator rebind_degree(std::size_t m) const {
+		return shared_ptr_allocator(m);
+	}
+
 	// rst:		.. function:: pointer make()
 	// rst:
 	// rst:			:returns: `std::make_shared<perm>(perm_group::make_perm<perm>(degree()))`
@@ -4,10 +4,213 @@
 #include <perm_group/transversal/transversal.hpp>
 #include <perm_group/group/generated.hpp>
 #include <perm_group/group/stabilizer_chain.hpp>
+#include <perm_group/permutation/materialize.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 namespace perm_group {
+namespace detail {
+
+// A relabeling of the support of a set of permutations to the domain [0, m[,
+// preserving the order of the elements.
+
+template<typename ValueType>
+struct domain_relabeling {
+	static constexpr ValueType none = std::numeric_limits<ValueType>::max();
+public:
+
+	explicit domain_relabeling(std::size_t n) : n(n), to_compact(n, none) { }
+
+	std::size_t degree() const {
+		return n;
+	}
+
+	std::size_t compact_degree() const {
+		return from_compact.size();
+	}
+
+	bool is_identity() const {
+		return compact_degree() == degree();
+	}
+
+	ValueType to_original(ValueType c) const {
+		return from_compact[c];
+	}
+
+	// returns none for elements outside the support
+	ValueType to_compact_or_none(ValueType i) const {
+		return to_compact[i];
+	}
+
+	// Extend the support with the elements moved by the given permutations.
+	// Returns true if the support changed.
+
+	template<typename Iter>
+	bool extend(Iter first, Iter last) {
+		std::vector<ValueType> added;
+		for(; first != last; ++first)
+			add_moved(**first, added, has_support<decltype(**first)>());
+		if(added.empty()) return false;
+		std::sort(added.begin(), added.end());
+		added.erase(std::unique(added.begin(), added.end()), added.end());
+		const auto mid = from_compact.size();
+		from_compact.insert(from_compact.end(), added.begin(), added.end());
+		std::inplace_merge(from_compact.begin(), from_compact.begin() + mid, from_compact.end());
+		for(std::size_t c = 0; c != from_compact.size(); ++c)
+			to_compact[from_compact[c]] = c;
+		return true;
+	}
+
+	// Whether p fixes every element outside the support.
+	// As p is a bijection it then also maps the support onto itself.
+
+	template<typename Perm>
+	bool fixes_complement(const Perm &p) const {
+		return fixes_complement(p, has_support<Perm>());
+	}
+private:
+
+	template<typename Perm>
+	void add_moved(const Perm &p, std::vector<ValueType> &added, std::true_type) const {
+		perm_group::for_each_support_point(p, [&](const auto &x) {
+			if(to_compact[x] == none && perm_group::get(p, x) != x)
+				added.push_back(x);
+			return true;
+		});
+	}
+
+	template<typename Perm>
+	void add_moved(const Perm &p, std::vector<ValueType> &added, std::false_type) const {
+		for(std::size_t i = 0; i != n; ++i)
+			if(to_compact[i] == none && perm_group::get(p, i) != i)
+				added.push_back(i);
+	}
+
+	template<typename Perm>
+	bool fixes_complement(const Perm &p, std::true_type) const {
+		return perm_group::for_each_support_point(p, [&](const auto &x) {
+			return to_compact[x] != none || perm_group::get(p, x) == x;
+		});
+	}
+
+	template<typename Perm>
+	bool fixes_complement(const Perm &p, std::false_type) const {
+		for(std::size_t i = 0; i != n; ++i)
+			if(to_compact[i] == none && perm_group::get(p, i) != i)
+				return false;
+		return true;
+	}
+private:
+	std::size_t n;
+	std::vector<ValueType> from_compact;
+	std::vector<ValueType> to_compact;
+};
+
+template<typename ValueType>
+constexpr ValueType domain_relabeling<ValueType>::none;
+
+// A permutation on the original domain viewed on the compact domain.
+// Requires that the permutation maps the support onto itself.
+
+template<typename Perm, typename ValueType>
+struct compressed_view {
+	using value_type = ValueType;
+public:
+
+	compressed_view(const Perm &p, const domain_relabeling<ValueType> &relabel) : p(p), relabel(relabel) { }
+
+	value_type get_(value_type c) const {
+		return relabel.to_compact_or_none(perm_group::get(p, relabel.to_original(c)));
+	}
+
+	std::size_t degree_() const {
+		return relabel.compact_degree();
+	}
+private:
+	const Perm &p;
+	const domain_relabeling<ValueType> &relabel;
+};
+
+// A permutation on the compact domain viewed on the original domain.
+
+template<typename Perm, typename ValueType>
+struct decompressed_view {
+	using value_type = ValueType;
+public:
+
+	decompressed_view(const Perm &p, const domain_relabeling<ValueType> &relabel) : p(p), relabel(relabel) { }
+
+	value_type get_(value_type i) const {
+		const auto c = relabel.to_compact_or_none(i);
+		if(c == relabel.none) return i;
+		return relabel.to_original(perm_group::get(p, c));
+	}
+
+	std::size_t degree_() const {
+		return relabel.degree();
+	}
+private:
+	const Perm &p;
+	const domain_relabeling<ValueType> &relabel;
+};
+
+// Gives the user-provided base point provider the permutations in the original labels,
+// and translates the result back. A null relabeling means the identity.
+
+template<typename BasePointProvider, typename ValueType>
+struct compact_base_point_provider {
+
+	compact_base_point_provider(BasePointProvider bpp, const domain_relabeling<ValueType> *relabel)
+	: bpp(bpp), relabel(relabel) { }
+
+	template<typename Perm>
+	typename permutation_traits<Perm>::value_type operator()(const Perm &p) const {
+		if(!relabel || relabel->is_identity()) return bpp(p);
+		return call(p, std::is_same<BasePointProvider, base_point_first_moved>());
+	}
+private:
+
+	template<typename Perm>
+	typename permutation_traits<Perm>::value_type call(const Perm &p, std::true_type) const {
+		// the relabeling preserves the order of elements
+		return bpp(p);
+	}
 
-template<typename Transversal, typename BasePointProvider = base_point_first_moved>
+	template<typename Perm>
+	typename permutation_traits<Perm>::value_type call(const Perm &p, std::false_type) const {
+		const auto b = bpp(decompressed_view<Perm, ValueType>(p, *relabel));
+		const auto c = relabel->to_compact_or_none(b);
+		// a base point outside the support is fixed by everything, use a moved one instead
+		if(c == relabel->none) return base_point_first_moved()(p);
+		return c;
+	}
+private:
+	BasePointProvider bpp;
+	const domain_relabeling<ValueType> *relabel;
+};
+
+} // namespace detail
+
+// rst: .. class:: template<typename Transversal, typename BasePointProvider = base_point_first_moved, bool CompressDomain = false> \
+// rst:            generating_system
+// rst:
+// rst:		A group represented by a generating set together with a `stabilizer_chain` for membership testing.
+// rst:
+// rst:		If `CompressDomain` is `true`, the stabilizer chain is built on the support of the generators,
+// rst:		relabeled to a compact domain while preserving the order of elements.
+// rst:		This requires the allocator to support `rebind_degree` (see `has_rebind_degree`).
+// rst:		Transversals and orbits then scale with the number of moved elements instead of the degree.
+// rst:		The relabeling is transparent: generators are reported and membership queries are answered
+// rst:		in the original labels, and the `BasePointProvider` is given permutations in the original labels.
+// rst:		When a new generator extends the support, the chain is rebuilt from all generators,
+// rst:		so it pays off when the generators with the largest supports are added first.
+// rst:
+
+template<typename Transversal, typename BasePointProvider = base_point_first_moved, bool CompressDomain = false>
 struct generating_system {
 	BOOST_CONCEPT_ASSERT((TransversalConcept<Transversal>));
 public: // Group
@@ -15,8 +218,15 @@ public: // Group
 	using perm = typename allocator::perm;
 	using pointer = typename allocator::pointer;
 	using const_pointer = typename allocator::const_pointer;
+	using value_type = typename permutation_traits<perm>::value_type;
 private:
-	using Chain = stabilizer_chain<Transversal, BasePointProvider>;
+	using Relabeling = detail::domain_relabeling<value_type>;
+	using ChainBasePointProvider = detail::compact_base_point_provider<BasePointProvider, value_type>;
+	using Chain = stabilizer_chain<Transversal, ChainBasePointProvider>;
+	using CompactGroup = generated_group<allocator>;
+	using CanCompress = std::integral_constant<bool, CompressDomain>;
+	static_assert(!CompressDomain || has_rebind_degree<allocator>::value,
+			"A compressed domain requires an allocator with rebind_degree.");
 private:
 
 	struct DupChecker {
@@ -32,34 +242,55 @@ private:
 	};
 public:
 
-	explicit generating_system(const allocator &alloc) : gen(alloc, DupChecker(this)), bpp(BasePointProvider()) { }
+	explicit generating_system(const allocator &alloc) : generating_system(alloc, BasePointProvider()) { }
 
-	explicit generating_system(const allocator &alloc, BasePointProvider bpp) : gen(alloc, DupChecker(this)), bpp(bpp) { }
+	explicit generating_system(const allocator &alloc, BasePointProvider bpp)
+	: gen(alloc, DupChecker(this)), bpp(bpp), relabel(alloc.degree()) { }
 
 	explicit generating_system(std::size_t n) : generating_system(allocator(n)) { }
 
 	generating_system(generating_system &&other) = delete;
 	generating_system &operator=(generating_system &&other) = delete;
 
+	~generating_system() {
+		release_scratch();
+	}
+
 	template<typename UPerm>
 	void add_generator(UPerm &&perm) {
 		gen.add_generator(std::forward<UPerm>(perm), [this](auto first, auto lastOld, auto lastNew) {
-			if(!chain) {
-				auto toFix = bpp(**lastOld);
-				chain.reset(new Chain(toFix, get_allocator(), bpp));
-			}
-			chain->add_generators(first, lastOld, lastNew);
+			this->update_chain(first, lastOld, lastNew, CanCompress());
 		});
 	}
 
-	bool is_member(const perm &p) const {
+	// rst:		.. function:: template<typename Perm> \
+	// rst:		              bool is_member(const Perm &p) const
+	// rst:
+	// rst:			Requires `Permutation<Perm>`.
+	// rst:
+	// rst:			:returns: whether `p` is an element of the group.
+	// rst:			  The permutation does not need to be of type `perm`, e.g., it can be a `span_permutation`.
+	// rst:
+	// rst:			On a compressed domain the query is written into a scratch permutation owned by the group,
+	// rst:			so concurrent calls on the same group are not safe.
+
+	template<typename Perm>
+	bool is_member(const Perm &p) const {
 		if(!chain) {
 			assert(generators().size() == 1);
-			return p == *generators().begin();
+			return perm_group::is_identity(p, degree());
 		} else {
-			return chain->is_member_of_parent(p);
+			return is_member(p, CanCompress());
 		}
 	}
+
+	// rst:		.. function:: std::size_t compact_degree() const
+	// rst:
+	// rst:			:returns: the degree of the domain the stabilizer chain is built on.
+
+	std::size_t compact_degree() const {
+		return CanCompress::value ? relabel.compact_degree() : degree();
+	}
 public: // GroupConcept
 
 	decltype(auto) degree() const {
@@ -78,11 +309,86 @@ public: // GroupConcept
 		return gen.get_allocator();
 	}
 private:
+
+	ChainBasePointProvider chain_bpp() const {
+		return ChainBasePointProvider(bpp, CanCompress::value ? &relabel : nullptr);
+	}
+
+	template<typename Iter>
+	void update_chain(Iter first, Iter lastOld, Iter lastNew, std::false_type) {
+		if(!chain) {
+			auto toFix = chain_bpp()(**lastOld);
+			chain.reset(new Chain(toFix, get_allocator(), chain_bpp()));
+		}
+		chain->add_generators(first, lastOld, lastNew);
+	}
+
+	template<typename Iter>
+	void update_chain(Iter first, Iter lastOld, Iter lastNew, std::true_type) {
+		const bool grown = relabel.extend(lastOld, lastNew);
+		if(grown) {
+			// the compact domain changed, so rebuild everything from the original generators
+			chain.reset();
+			release_scratch();
+			compact.reset();
+			if(relabel.is_identity()) {
+				make_chain(get_allocator(), **(first + 1));
+				chain->add_generators(first, first + 1, lastNew);
+			} else {
+				compact.reset(new CompactGroup(get_allocator().rebind_degree(relabel.compact_degree())));
+				for(Iter iter = first + 1; iter != lastNew; ++iter)
+					compact->add_generator(detail::compressed_view<perm, value_type>(**iter, relabel));
+				scratch = compact->get_allocator().make();
+				const auto gens = compact->generator_ptrs();
+				make_chain(compact->get_allocator(), **(gens.begin() + 1));
+				chain->add_generators(gens.begin(), gens.begin() + 1, gens.end());
+			}
+		} else if(relabel.is_identity()) {
+			chain->add_generators(first, lastOld, lastNew);
+		} else {
+			for(Iter iter = lastOld; iter != lastNew; ++iter) {
+				compact->add_generator(detail::compressed_view<perm, value_type>(**iter, relabel),
+						[this](auto cFirst, auto cLastOld, auto cLastNew) {
+							this->chain->add_generators(cFirst, cLastOld, cLastNew);
+						});
+			}
+		}
+	}
+
+	void make_chain(const allocator &alloc, const perm &firstGen) {
+		auto toFix = chain_bpp()(firstGen);
+		chain.reset(new Chain(toFix, alloc, chain_bpp()));
+	}
+
+	template<typename Perm>
+	bool is_member(const Perm &p, std::false_type) const {
+		return chain->is_member_of_parent(p);
+	}
+
+	template<typename Perm>
+	bool is_member(const Perm &p, std::true_type) const {
+		if(relabel.is_identity()) return chain->is_member_of_parent(p);
+		// everything outside the support is fixed by the group
+		if(!relabel.fixes_complement(p)) return false;
+		perm_group::materialize(detail::compressed_view<Perm, value_type>(p, relabel), *scratch, relabel.compact_degree());
+		return chain->is_member_of_parent(*scratch);
+	}
+
+	void release_scratch() {
+		if(!compact) return;
+		compact->get_allocator().release(std::move(scratch));
+		scratch = pointer();
+	}
+private:
 	generated_group<allocator, DupChecker> gen;
 	std::unique_ptr<Chain> chain;
 	BasePointProvider bpp;
+private: // for the compressed domain
+	Relabeling relabel;
+	std::unique_ptr<CompactGroup> compact;
+	pointer scratch = pointer();
 };
 
 } // namespace perm_group
 
-#endif /* PERM_GROUP_GROUP_GENERATING_SYSTEM_HPP */
\ No newline at end of file
+#endif /* PERM_GROUP_GROUP_GENERATING_SYSTEM_HPP */
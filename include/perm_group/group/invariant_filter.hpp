@@ -0,0 +1,204 @@
+#ifndef PERM_GROUP_GROUP_INVARIANT_FILTER_HPP
+#define PERM_GROUP_GROUP_INVARIANT_FILTER_HPP
+
+#include <perm_group/permutation/cycles.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            invariant_filter
+// rst:
+// rst:		Necessary conditions for membership in a group, which can be checked in O(n) time
+// rst:		without sifting through a stabilizer chain.
+// rst:		The filter always contains the orbit partition of the group,
+// rst:		as every element maps each orbit onto itself.
+// rst:		For groups of small order the filter also contains the set of cycle types of all group elements,
+// rst:		found by enumerating the group.
+// rst:		The filter describes the group at the time it was constructed, and must be rebuilt if the group changes.
+// rst:
+
+template<typename ValueType>
+struct invariant_filter {
+	using value_type = ValueType;
+public:
+
+	// rst:		.. function:: template<typename Chain> \
+	// rst:		              invariant_filter(const Chain &chain, std::uintmax_t maxOrder)
+	// rst:
+	// rst:			Construct the filter for the group whose membership is tested by `chain.is_member_of_parent`,
+	// rst:			where `chain` is a `stabilizer_chain`.
+	// rst:			The group is enumerated for cycle types if its order is at most `maxOrder`,
+	// rst:			which takes O(maxOrder * n) time.
+
+	template<typename Chain>
+	invariant_filter(const Chain &chain, std::uintmax_t maxOrder) : n(chain.degree()) {
+		init_orbits(chain);
+		std::uintmax_t groupOrder = 1;
+		for(const auto *level = &chain; level; level = level->get_next()) {
+			const std::uintmax_t size = level->transversal().orbit().end() - level->transversal().orbit().begin();
+			if(groupOrder > maxOrder / size) return;
+			groupOrder *= size;
+		}
+		order = groupOrder;
+		std::vector<std::vector<value_type> > prefixes;
+		for(const auto *level = &chain; level; level = level->get_next())
+			prefixes.emplace_back(n);
+		enumerate(&chain, 0, prefixes);
+	}
+
+	// rst:		.. function:: bool has_cycle_types() const
+	// rst:
+	// rst:			:returns: whether the group was enumerated for cycle types.
+
+	bool has_cycle_types() const {
+		return order != 0;
+	}
+
+	// rst:		.. function:: std::uintmax_t group_order() const
+	// rst:
+	// rst:			Requires `has_cycle_types()`.
+	// rst:
+	// rst:			:returns: the order of the group.
+
+	std::uintmax_t group_order() const {
+		assert(has_cycle_types());
+		return order;
+	}
+
+	// rst:		.. function:: const std::set<std::vector<std::size_t> > &cycle_types() const
+	// rst:
+	// rst:			Requires `has_cycle_types()`.
+	// rst:
+	// rst:			:returns: the cycle types of the group elements, as given by `cycle_decomposition::cycle_type`.
+
+	const std::set<std::vector<std::size_t> > &cycle_types() const {
+		assert(has_cycle_types());
+		return types;
+	}
+
+	// rst:		.. function:: const std::set<std::uintmax_t> &element_orders() const
+	// rst:
+	// rst:			Requires `has_cycle_types()`.
+	// rst:
+	// rst:			:returns: the orders of the group elements.
+
+	const std::set<std::uintmax_t> &element_orders() const {
+		assert(has_cycle_types());
+		return orders;
+	}
+
+	// rst:		.. function:: value_type orbit_id(value_type i) const
+	// rst:
+	// rst:			:returns: the smallest element in the orbit of `i`.
+
+	value_type orbit_id(value_type i) const {
+		return orbitOf[i];
+	}
+
+	// rst:		.. function:: template<typename Perm> \
+	// rst:		              bool accepts(const Perm &p) const
+	// rst:
+	// rst:			:returns: `false` if `p` is certainly not in the group.
+	// rst:			  Otherwise `p` may or may not be in the group.
+	// rst:			  Only the support is checked for orbit compatibility if `p` is support aware.
+
+	template<typename Perm>
+	bool accepts(const Perm &p) const {
+		if(!respects_orbits(p, has_support<Perm>())) return false;
+		if(!has_cycle_types()) return true;
+		// the cycle type also determines the element order
+		return types.find(perm_group::cycle_type(p, n)) != types.end();
+	}
+private:
+
+	template<typename Chain>
+	void init_orbits(const Chain &chain) {
+		// the group is generated by the first transversal together with the generators of the stabilizer
+		orbitOf.resize(n);
+		for(std::size_t i = 0; i != n; ++i) orbitOf[i] = i;
+		const auto &trans = chain.transversal();
+		for(const auto o : trans.orbit())
+			join(trans.from_element(o));
+		for(const auto &g : chain.generators())
+			join(g);
+		for(std::size_t i = 0; i != n; ++i)
+			orbitOf[i] = find(i);
+	}
+
+	template<typename Perm>
+	void join(const Perm &p) {
+		for(std::size_t i = 0; i != n; ++i) {
+			const auto a = find(i);
+			const auto b = find(perm_group::get(p, i));
+			// keep the smallest element as the root
+			if(a < b) orbitOf[b] = a;
+			else if(b < a) orbitOf[a] = b;
+		}
+	}
+
+	value_type find(value_type i) {
+		while(orbitOf[i] != i) {
+			orbitOf[i] = orbitOf[orbitOf[i]];
+			i = orbitOf[i];
+		}
+		return i;
+	}
+
+	// Elements are products t_k ... t_1 of transversal elements, with t_k applied first,
+	// as that is the order in which sifting factors them.
+
+	template<typename Chain>
+	void enumerate(const Chain *level, std::size_t depth, std::vector<std::vector<value_type> > &prefixes) {
+		if(!level) {
+			const auto cd = perm_group::make_cycle_decomposition(prefixes[depth - 1], n);
+			orders.insert(cd.order());
+			types.insert(cd.cycle_type());
+			return;
+		}
+		const auto &trans = level->transversal();
+		auto &cur = prefixes[depth];
+		for(const auto o : trans.orbit()) {
+			const auto &t = trans.from_element(o);
+			if(depth == 0) {
+				for(std::size_t i = 0; i != n; ++i)
+					cur[i] = perm_group::get(t, i);
+			} else {
+				const auto &prev = prefixes[depth - 1];
+				for(std::size_t i = 0; i != n; ++i)
+					cur[i] = prev[perm_group::get(t, i)];
+			}
+			enumerate(level->get_next(), depth + 1, prefixes);
+		}
+	}
+
+	template<typename Perm>
+	bool respects_orbits(const Perm &p, std::true_type) const {
+		return perm_group::for_each_support_point(p, [&](const auto &x) {
+			return orbitOf[perm_group::get(p, x)] == orbitOf[x];
+		});
+	}
+
+	template<typename Perm>
+	bool respects_orbits(const Perm &p, std::false_type) const {
+		for(std::size_t i = 0; i != n; ++i)
+			if(orbitOf[perm_group::get(p, i)] != orbitOf[i])
+				return false;
+		return true;
+	}
+private:
+	std::size_t n;
+	std::vector<value_type> orbitOf;
+	std::uintmax_t order = 0;
+	std::set<std::vector<std::size_t> > types;
+	std::set<std::uintmax_t> orders;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_GROUP_INVARIANT_FILTER_HPP */
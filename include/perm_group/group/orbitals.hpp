@@ -0,0 +1,195 @@
+#ifndef PERM_GROUP_GROUP_ORBITALS_HPP
+#define PERM_GROUP_GROUP_ORBITALS_HPP
+
+#include <perm_group/group/generated.hpp>
+#include <perm_group/orbit/partition.hpp>
+#include <perm_group/permutation/permutation.hpp>
+
+#include <cassert>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            orbital
+// rst:
+// rst:		An orbit of a group on ordered pairs of points.
+// rst:
+
+template<typename ValueType>
+struct orbital {
+	// rst:		.. var:: ValueType first
+	// rst:		         ValueType second
+	// rst:
+	// rst:			A representative pair, where `first` is the representative of its orbit on points,
+	// rst:			and `second` is the smallest point in its orbit under the stabilizer of `first`.
+	ValueType first, second;
+	// rst:		.. var:: std::size_t size
+	// rst:
+	// rst:			The number of pairs in the orbital.
+	std::size_t size;
+};
+
+// rst: .. class:: template<typename Chain> \
+// rst:            orbital_decomposition
+// rst:
+// rst:		The orbitals of the group represented by a `stabilizer_chain`, i.e., the orbits on ordered pairs of points,
+// rst:		which are the arc colours of the 2-closure of the group.
+// rst:
+// rst:		The orbitals with the first point in the orbit of a point `a` correspond to the orbits of the stabilizer of `a`:
+// rst:		the orbital with representative `(a, c)` is the set of pairs `(t(a), t(x))`,
+// rst:		where `t` runs through a transversal of the orbit of `a` and `x` through the orbit of `c` under the stabilizer.
+// rst:		The chain has both for its base point, so for a transitive group the orbitals are found
+// rst:		from the orbits of the first stabilizer, without enumerating the pairs.
+// rst:		For each other orbit on points, a chain of the same type is built with the representative as base point,
+// rst:		from the labels of the Schreier tree of the first transversal and the generators of the first stabilizer.
+// rst:
+// rst:		The given chain must outlive the decomposition.
+// rst:
+
+template<typename Chain>
+struct orbital_decomposition {
+	using allocator = typename Chain::allocator;
+	using perm = typename Chain::perm;
+	using value_type = typename permutation_traits<perm>::value_type;
+public:
+
+	// rst:		.. function:: explicit orbital_decomposition(const Chain &chain)
+
+	explicit orbital_decomposition(const Chain &chain) : n(chain.degree()), orbitOf(n, npos) {
+		const auto &trans = chain.transversal();
+		const value_type root = chain.fixed_element();
+		// the group is generated by the labels of the Schreier tree of the first transversal
+		// together with the generators of the stabilizer
+		std::set<std::vector<value_type> > labels;
+		std::vector<value_type> label(n);
+		for(const auto o : trans.orbit()) {
+			if(o == root) continue;
+			const auto &tPred = trans.from_element(trans.predecessor(o));
+			const auto &t = trans.from_element(o);
+			for(std::size_t i = 0; i != n; ++i)
+				label[perm_group::get(tPred, i)] = perm_group::get(t, i);
+			labels.insert(label);
+		}
+		orbit_partition<value_type> points(n);
+		for(const auto &l : labels) points.add_generator(l);
+		for(const auto &g : chain.generators()) points.add_generator(g);
+
+		levels.push_back(&chain);
+		for(const auto &orbit : points.orbits()) {
+			if(points.same_orbit(orbit.front(), root)) continue;
+			allocator alloc = chain.get_allocator();
+			std::unique_ptr<Chain> other(new Chain(orbit.front(), alloc));
+			generated_group<allocator> group(alloc);
+			const auto next = [&](auto first, auto lastOld, auto lastNew) {
+				other->add_generators(first, lastOld, lastNew);
+			};
+			for(const auto &l : labels) group.add_generator(l, next);
+			for(const auto &g : chain.generators()) group.add_generator(g, next);
+			levels.push_back(other.get());
+			owned.push_back(std::move(other));
+		}
+
+		for(std::size_t k = 0; k != levels.size(); ++k) {
+			const Chain &level = *levels[k];
+			const value_type a = level.fixed_element();
+			std::size_t orbitSize = 0;
+			for(const auto o : level.transversal().orbit()) {
+				orbitOf[o] = k;
+				++orbitSize;
+			}
+			orbit_partition<value_type> sub(n);
+			for(const auto &g : level.generators()) sub.add_generator(g);
+			suborbitOf.emplace_back(n);
+			for(const auto &cell : sub.orbits()) {
+				for(const auto x : cell)
+					suborbitOf.back()[x] = orbs.size();
+				orbs.push_back(orbital<value_type>{a, cell.front(), orbitSize * cell.size()});
+				cells.push_back(cell);
+				levelOf.push_back(k);
+			}
+		}
+	}
+
+	// rst:		.. function:: std::size_t num_orbitals() const
+
+	std::size_t num_orbitals() const {
+		return orbs.size();
+	}
+
+	// rst:		.. function:: const std::vector<orbital<value_type> > &orbitals() const
+	// rst:
+	// rst:			:returns: the orbitals, grouped by the orbits on points of their first points.
+
+	const std::vector<orbital<value_type> > &orbitals() const {
+		return orbs;
+	}
+
+	// rst:		.. function:: std::size_t orbital_of(value_type u, value_type v) const
+	// rst:
+	// rst:			:returns: the index of the orbital containing `(u, v)`.
+	// rst:				This takes :math:`O(n)` time, for finding the preimage of `v` under the transversal element of `u`.
+
+	std::size_t orbital_of(value_type u, value_type v) const {
+		const std::size_t k = orbitOf[u];
+		const auto &t = levels[k]->transversal().from_element(u);
+		for(std::size_t x = 0; x != n; ++x)
+			if(perm_group::get(t, x) == v) return suborbitOf[k][x];
+		assert(false);
+		return npos;
+	}
+
+	// rst:		.. function:: std::size_t paired(std::size_t i) const
+	// rst:
+	// rst:			:returns: the index of the paired orbital, i.e., the one containing the reversed pairs of orbital `i`.
+
+	std::size_t paired(std::size_t i) const {
+		return orbital_of(orbs[i].second, orbs[i].first);
+	}
+
+	// rst:		.. function:: template<typename F> void for_each_edge(std::size_t i, F f) const
+	// rst:		              template<typename F> void for_each_edge(F f) const
+	// rst:
+	// rst:			Stream the pairs of orbital `i`, calling `f(u, v)` for each pair, i.e., the edges of the orbital graph,
+	// rst:			or of all orbitals, calling `f(i, u, v)`.
+	// rst:			Each pair is generated once, without storing the orbital.
+
+	template<typename F>
+	void for_each_edge(std::size_t i, F f) const {
+		const auto &trans = levels[levelOf[i]]->transversal();
+		for(const auto u : trans.orbit()) {
+			const auto &t = trans.from_element(u);
+			for(const auto x : cells[i])
+				f(static_cast<value_type> (u), static_cast<value_type> (perm_group::get(t, x)));
+		}
+	}
+
+	template<typename F>
+	void for_each_edge(F f) const {
+		for(std::size_t i = 0; i != orbs.size(); ++i)
+			for_each_edge(i, [&f, i](value_type u, value_type v) {
+				f(i, u, v);
+			});
+	}
+private:
+	static constexpr std::size_t npos = -1;
+	std::size_t n;
+	// the chains with the representatives of the orbits on points as base points, the given one first
+	std::vector<const Chain*> levels;
+	std::vector<std::unique_ptr<Chain> > owned;
+	std::vector<std::size_t> orbitOf;
+	// for each orbit on points, the orbital of each pair with its representative
+	std::vector<std::vector<std::size_t> > suborbitOf;
+	std::vector<orbital<value_type> > orbs;
+	std::vector<std::vector<value_type> > cells;
+	std::vector<std::size_t> levelOf;
+};
+
+template<typename Chain>
+constexpr std::size_t orbital_decomposition<Chain>::npos;
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_GROUP_ORBITALS_HPP */
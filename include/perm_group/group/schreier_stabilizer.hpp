@@ -2,6 +2,7 @@
 #define PERM_GROUP_GROUP_SCHREIER_STABILIZER_HPP
 
 #include <perm_group/group/group.hpp>
+#include <perm_group/permutation/materialize.hpp>
 #include <perm_group/permutation/mult.hpp>
 #include <perm_group/transversal/transversal.hpp>
 #include <perm_group/util/iterators.hpp>
@@ -120,16 +121,16 @@ public: // StabilizerConcept
 			} else if(u == root) { // then T[u] == id
 				const_pointer trans_u_img_inv = inverse_trans[trans.orbit().position(u_img)];
 				auto gen_expr = perm_group::mult(**gen_iter, *trans_u_img_inv);
-				cand = this->get_allocator().copy(gen_expr);
+				cand = perm_group::make_materialized(this->get_allocator(), gen_expr);
 			} else if(u_img == root) { // then T[g(u)]^- == id
 				const_pointer trans_u = trans.from_element_as_ptr(u);
 				auto gen_expr = perm_group::mult(*trans_u, **gen_iter);
-				cand = this->get_allocator().copy(gen_expr);
+				cand = perm_group::make_materialized(this->get_allocator(), gen_expr);
 			} else {
 				const_pointer trans_u = trans.from_element_as_ptr(u);
 				const_pointer trans_u_img_inv = inverse_trans[trans.orbit().position(u_img)];
 				auto gen_expr = perm_group::mult(perm_group::mult(*trans_u, **gen_iter), *trans_u_img_inv);
-				cand = this->get_allocator().copy(gen_expr);
+				cand = perm_group::make_materialized(this->get_allocator(), gen_expr);
 			}
 			// check if we already have it
 			const auto gens = this->generators();
@@ -167,7 +168,7 @@ public:
 		const_pointer factor = sift_factor(p);
 		if(!factor) return nullptr;
 		auto comp = perm_group::mult(p, *factor);
-		return get_allocator().copy(comp);
+		return perm_group::make_materialized(get_allocator(), comp);
 	}
 public:
 
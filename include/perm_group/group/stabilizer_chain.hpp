@@ -2,7 +2,9 @@
 #define PERM_GROUP_GROUP_STABILIZER_CHAIN_HPP
 
 #include <perm_group/group/generated.hpp>
+#include <perm_group/group/invariant_filter.hpp>
 #include <perm_group/group/schreier_stabilizer.hpp>
+#include <perm_group/permutation/support.hpp>
 #include <perm_group/permutation/word.hpp>
 
 #include <vector>
@@ -22,11 +24,9 @@ struct base_point_first_moved {
 
 	template<typename Perm>
 	typename permutation_traits<Perm>::value_type operator()(const Perm &p) const {
-		for(typename permutation_traits<Perm>::value_type i = 0; i != perm_group::degree(p); ++i) {
-			if(perm_group::get(p, i) != i)
-				return i;
-		}
-		return 0;
+		const std::size_t n = perm_group::degree(p);
+		const std::size_t i = perm_group::first_moved(p, n);
+		return i == n ? 0 : i;
 	}
 };
 
@@ -66,6 +66,7 @@ public:
 		using std::swap;
 		swap(stab, other.stab);
 		swap(next, other.next);
+		swap(filter, other.filter);
 		stab.dupChecker.owner = this;
 		other.stab.dupChecker.owner = &other;
 	}
@@ -75,6 +76,7 @@ public:
 		swap(bpp, other.bpp);
 		swap(stab, other.stab);
 		swap(next, other.next);
+		swap(filter, other.filter);
 		stab.dupChecker.owner = this;
 		other.stab.dupChecker.owner = &other;
 	}
@@ -97,6 +99,8 @@ public: // StabilizerConcept
 		for(auto iter = lastOld; iter != lastNew; ++iter)
 			write_permutation_cycles(std::cout << "\t", **iter) << std::endl;
 #endif
+		// the group changes, so the filter may reject new members
+		filter.reset();
 		stab.add_generators(first, lastOld, lastNew, [&](auto firstInner, auto lastOldInner, auto lastNewInner) {
 			// first complete the addition to the chain
 			if(!this->next) { // add another level
@@ -110,7 +114,8 @@ public: // StabilizerConcept
 	}
 public:
 
-	bool is_member(const perm &p) const {
+	template<typename Perm>
+	bool is_member(const Perm &p) const {
 #ifdef PERM_GROUP_STABILIZER_CHAIN_DEBUG
 		write_permutation_cycles(std::cout << "is_member(" << this << ", ", p) << "): ";
 		std::cout << "next = " << next.get() << std::endl;
@@ -119,16 +124,18 @@ public:
 #endif
 		if(!next) {
 			assert(generators().size() == 1);
-			return p == *generators().begin();
+			return perm_group::is_identity(p, degree());
 		} else {
 			return next->is_member_of_parent(p);
 		}
 	}
 
-	bool is_member_of_parent(const perm &p) const {
+	template<typename Perm>
+	bool is_member_of_parent(const Perm &p) const {
 #ifdef PERM_GROUP_STABILIZER_CHAIN_DEBUG
 		write_permutation_cycles(std::cout << "is_member_of_parent(" << this << ", ", p) << "):" << std::endl;
 #endif
+		if(filter && !filter->accepts(p)) return false;
 		word.clear();
 		const auto rest = perm_group::mult(p, word); // note, this changes when word changes
 
@@ -181,14 +188,37 @@ public:
 #endif
 		// if it's the identity we have it
 		if(word.empty()) { // optimization: no point in involving the word if it's id
-			return p == *generators().begin();
+			return perm_group::is_identity(p, degree());
 		} else {
-			for(value_type i = 0; i != degree(); ++i) {
-				if(perm_group::get(rest, i) != i)
-					return false;
-			}
+			// for support aware permutations only the support is checked
+			return perm_group::is_identity(rest, degree());
 		}
-		return true;
+	}
+
+	// rst:		.. function:: void build_invariant_filter(std::uintmax_t maxOrder)
+	// rst:
+	// rst:			Construct an `invariant_filter` for the current group with the given `maxOrder`,
+	// rst:			which `is_member_of_parent` then uses to reject most non-members in O(n) time.
+	// rst:			The filter is discarded when generators are added.
+
+	void build_invariant_filter(std::uintmax_t maxOrder) {
+		filter.reset(new invariant_filter<value_type>(*this, maxOrder));
+	}
+
+	// rst:		.. function:: void clear_invariant_filter()
+	// rst:
+	// rst:			Discard the invariant filter, if any.
+
+	void clear_invariant_filter() {
+		filter.reset();
+	}
+
+	// rst:		.. function:: const invariant_filter<value_type> *get_invariant_filter() const
+	// rst:
+	// rst:			:returns: the invariant filter, or `nullptr` if there is none.
+
+	const invariant_filter<value_type> *get_invariant_filter() const {
+		return filter.get();
 	}
 
 	const stabilizer_chain *get_next() const {
@@ -219,6 +249,7 @@ private:
 	BasePointProvider bpp;
 	stabilizer stab;
 	std::unique_ptr<stabilizer_chain> next;
+	std::unique_ptr<invariant_filter<value_type> > filter;
 private:
 	mutable permutation_word<const_pointer> word;
 };
@@ -2,11 +2,16 @@
 #define PERM_GROUP_ORBIT_HPP
 
 #include <perm_group/permutation/permutation.hpp>
+#include <perm_group/permutation/support.hpp>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <vector>
 
 namespace perm_group {
 
@@ -125,6 +130,234 @@ private:
 	std::vector<ValueType> orbit_position;
 };
 
+// rst: .. class:: template<typename ValueType> \
+// rst:            InOrbitHandlerEpoch
+// rst:
+// rst:		Models `InOrbitHandler`.
+// rst:
+// rst:		Stores a generation number for each point, and a point is in the orbit
+// rst:		if its number is the current generation.
+// rst:		Clearing therefore only increments the current generation,
+// rst:		instead of resetting each element of the previous orbit.
+// rst:		All numbers are only reset when the generation counter wraps around.
+
+template<typename ValueType>
+struct InOrbitHandlerEpoch {
+
+	InOrbitHandlerEpoch(ValueType n) : stamp(n, 0), orbit_position(n) { }
+
+	template<typename Orbit>
+	void clear(ValueType w, const Orbit &orbit) {
+		if(++epoch == 0) {
+			std::fill(stamp.begin(), stamp.end(), 0);
+			epoch = 1;
+		}
+		stamp[w] = epoch;
+		orbit_position[w] = 0;
+	}
+
+	bool operator()(ValueType u) const {
+		return stamp[u] == epoch;
+	}
+
+	void add(ValueType img, std::size_t position) {
+		stamp[img] = epoch;
+		orbit_position[img] = position - 1;
+	}
+
+	// rst:		.. function:: ValueType position(ValueType u) const
+	// rst:
+	// rst:			Requires the clear method to have been called.
+	// rst:			Requires either `u` has been added or was the element given to the latest clear.
+	// rst:
+	// rst:			:returns: the position of `u` in the orbit. The initial orbit element is at position 0.
+
+	ValueType position(ValueType u) const {
+		return orbit_position[u];
+	}
+private:
+	std::uint32_t epoch = 0;
+	std::vector<std::uint32_t> stamp;
+	std::vector<ValueType> orbit_position;
+};
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            InOrbitHandlerHash
+// rst:
+// rst:		Models `InOrbitHandler`.
+// rst:
+// rst:		Stores the orbit elements and their positions in an open-addressing hash table with linear probing.
+// rst:		The memory use is proportional to the largest orbit seen, independent of the degree,
+// rst:		which suits small orbits in large domains.
+
+template<typename ValueType>
+struct InOrbitHandlerHash {
+
+	InOrbitHandlerHash(ValueType n) : keys(16, empty()), positions(16) { }
+
+	template<typename Orbit>
+	void clear(ValueType w, const Orbit &orbit) {
+		// we assume each orbit is sparse compared to the table
+		for(auto o : orbit)
+			erase(o);
+		assert(count == 0);
+		insert(w, 0);
+	}
+
+	bool operator()(ValueType u) const {
+		return keys[find(u)] == u;
+	}
+
+	void add(ValueType img, std::size_t position) {
+		insert(img, position - 1);
+	}
+
+	// rst:		.. function:: ValueType position(ValueType u) const
+	// rst:
+	// rst:			See `InOrbitHandlerVector::position`.
+
+	ValueType position(ValueType u) const {
+		const std::size_t slot = find(u);
+		assert(keys[slot] == u);
+		return positions[slot];
+	}
+
+	// rst:		.. function:: std::size_t size() const
+	// rst:
+	// rst:			:returns: the number of elements in the orbit.
+
+	std::size_t size() const {
+		return count;
+	}
+
+	// rst:		.. function:: template<typename F> void for_each(F f) const
+	// rst:
+	// rst:			Call `f(u, p)` for each element `u` in the orbit, at position `p`, in no particular order.
+
+	template<typename F>
+	void for_each(F f) const {
+		for(std::size_t i = 0; i != keys.size(); ++i)
+			if(keys[i] != empty()) f(keys[i], positions[i]);
+	}
+private:
+
+	static constexpr ValueType empty() {
+		return std::numeric_limits<ValueType>::max();
+	}
+
+	std::size_t home(ValueType u) const {
+		return (static_cast<std::uint64_t> (u) * 0x9E3779B97F4A7C15ull >> 32) & (keys.size() - 1);
+	}
+
+	std::size_t find(ValueType u) const {
+		const std::size_t mask = keys.size() - 1;
+		std::size_t slot = home(u);
+		while(keys[slot] != u && keys[slot] != empty())
+			slot = (slot + 1) & mask;
+		return slot;
+	}
+
+	void insert(ValueType u, ValueType position) {
+		assert(u != empty());
+		if(2 * (count + 1) > keys.size()) grow();
+		const std::size_t slot = find(u);
+		assert(keys[slot] == empty());
+		keys[slot] = u;
+		positions[slot] = position;
+		++count;
+	}
+
+	void erase(ValueType u) {
+		std::size_t slot = find(u);
+		if(keys[slot] != u) return;
+		keys[slot] = empty();
+		--count;
+		// shift back the following keys of the probe sequence which can no longer be reached
+		const std::size_t mask = keys.size() - 1;
+		for(std::size_t next = (slot + 1) & mask; keys[next] != empty(); next = (next + 1) & mask) {
+			// the key can stay if its home slot lies cyclically in (slot, next]
+			if(((next - home(keys[next])) & mask) < ((next - slot) & mask)) continue;
+			keys[slot] = keys[next];
+			positions[slot] = positions[next];
+			keys[next] = empty();
+			slot = next;
+		}
+	}
+
+	void grow() {
+		std::vector<ValueType> oldKeys(2 * keys.size(), empty()), oldPositions(2 * keys.size());
+		oldKeys.swap(keys);
+		oldPositions.swap(positions);
+		for(std::size_t i = 0; i != oldKeys.size(); ++i) {
+			if(oldKeys[i] == empty()) continue;
+			const std::size_t slot = find(oldKeys[i]);
+			keys[slot] = oldKeys[i];
+			positions[slot] = oldPositions[i];
+		}
+	}
+private:
+	std::size_t count = 0;
+	std::vector<ValueType> keys, positions;
+};
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            InOrbitHandlerAdaptive
+// rst:
+// rst:		Models `InOrbitHandler`.
+// rst:
+// rst:		Starts as an `InOrbitHandlerHash`, and switches to dense storage as in `InOrbitHandlerVector`
+// rst:		when an orbit grows beyond 1/16 of the degree, where the dense array is both faster and smaller.
+// rst:		It stays dense afterwards.
+
+template<typename ValueType>
+struct InOrbitHandlerAdaptive {
+
+	InOrbitHandlerAdaptive(ValueType n) : n(n), sparse(n) { }
+
+	template<typename Orbit>
+	void clear(ValueType w, const Orbit &orbit) {
+		if(dense.empty()) {
+			sparse.clear(w, orbit);
+		} else {
+			for(auto o : orbit)
+				dense[o] = 0;
+			dense[w] = 1;
+		}
+	}
+
+	bool operator()(ValueType u) const {
+		return dense.empty() ? sparse(u) : dense[u] != 0;
+	}
+
+	void add(ValueType img, std::size_t position) {
+		if(dense.empty()) {
+			if(sparse.size() < n / 16) {
+				sparse.add(img, position);
+				return;
+			}
+			dense.resize(n, 0);
+			sparse.for_each([this](ValueType u, ValueType p) {
+				dense[u] = p + 1;
+			});
+			sparse = InOrbitHandlerHash<ValueType>(n);
+		}
+		dense[img] = position;
+	}
+
+	// rst:		.. function:: ValueType position(ValueType u) const
+	// rst:
+	// rst:			See `InOrbitHandlerVector::position`.
+
+	ValueType position(ValueType u) const {
+		return dense.empty() ? sparse.position(u) : dense[u] - 1;
+	}
+private:
+	ValueType n;
+	InOrbitHandlerHash<ValueType> sparse;
+	// +1, 0 is used for "not in orbit", empty until switched
+	std::vector<ValueType> dense;
+};
+
 // rst: .. class:: template<typename ValueType, template<typename> class InOrbitHandlerT = InOrbitHandlerBitset> \
 // rst:            Orbit
 // rst:
@@ -206,6 +439,45 @@ struct Orbit {
 		return prevEnd == orbit.size();
 	}
 
+	// rst:		.. function:: template<typename Table, typename GenPtrIter, typename OnNewElement, typename OnDupElement> \
+	// rst:		              bool update(const Table &table, const GenPtrIter &first, const GenPtrIter &lastOld, const GenPtrIter &lastNew, OnNewElement onNewElement, OnDupElement onDupElement)
+	// rst:
+	// rst:			As the other `update`, but the images are read from `table`, e.g., a `generator_image_table`,
+	// rst:			where column `i` holds the images under the generator at `first + i`,
+	// rst:			for all generators `first` to `lastNew`.
+	// rst:			The generators themselves are not read, but the iterators are passed to the callbacks.
+
+	template<typename Table, typename GenPtrIter, typename OnNewElement, typename OnDupElement>
+	bool update(const Table &table, const GenPtrIter &first, const GenPtrIter &lastOld, const GenPtrIter &lastNew, OnNewElement onNewElement, OnDupElement onDupElement) {
+		const std::size_t numOld = std::distance(first, lastOld);
+		const std::size_t numGens = std::distance(first, lastNew);
+		assert(table.num_generators() >= numGens);
+		const auto visit = [&](ValueType oi, ValueType img, std::size_t g) {
+			if(!inOrbit(img)) {
+				orbit.push_back(img);
+				inOrbit.add(img, orbit.size());
+				onNewElement(oi, img, std::next(first, g));
+			} else {
+				onDupElement(oi, img, std::next(first, g));
+			}
+		};
+		const std::size_t prevEnd = orbit.size();
+		// same order as the other update, so the results are identical
+		for(std::size_t g = numOld; g != numGens; ++g) {
+			for(std::size_t i = 0; i != prevEnd; ++i) {
+				const auto oi = orbit[i];
+				visit(oi, table.image(oi, g), g);
+			}
+		}
+		for(std::size_t i = prevEnd; i != orbit.size(); ++i) {
+			const auto oi = orbit[i];
+			const auto *images = table.images(oi);
+			for(std::size_t g = 0; g != numGens; ++g)
+				visit(oi, images[g], g);
+		}
+		return prevEnd == orbit.size();
+	}
+
 	// rst:		.. function:: auto begin() const
 	// rst:
 	// rst:			:returns: an iterator to the first orbit element.
@@ -261,8 +533,24 @@ void orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, std::
 	using PermPtr = typename std::iterator_traits<GenPtrIter>::value_type;
 	using Perm = typename std::pointer_traits<PermPtr>::element_type;
 	using value_type = typename permutation_traits<Perm>::value_type;
-	Orbit<value_type> orbit(n, w);
 	onNewElement(w, w, last);
+	// with sparse generators most elements are fixed by all of them,
+	// so avoid allocating a degree-sized orbit for those
+	if(has_support<Perm>::value) {
+		bool isFixed = true;
+		for(GenPtrIter it = first; it != last; ++it) {
+			if(perm_group::get(**it, w) != w) {
+				isFixed = false;
+				break;
+			}
+		}
+		if(isFixed) {
+			for(GenPtrIter it = first; it != last; ++it)
+				onDupElement(w, w, it);
+			return;
+		}
+	}
+	Orbit<value_type> orbit(n, w);
 	orbit.update(first, first, last, onNewElement, onDupElement);
 }
 
@@ -277,6 +565,30 @@ void orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, OnNew
 	});
 }
 
+// rst: .. type:: template<typename ValueType> \
+// rst:           orbit_workspace = Orbit<ValueType, InOrbitHandlerEpoch>
+// rst:
+// rst:		An orbit calculator that can be reused for many orbit computations on the same degree,
+// rst:		without allocating or touching the previous orbit when it is cleared.
+
+template<typename ValueType>
+using orbit_workspace = Orbit<ValueType, InOrbitHandlerEpoch>;
+
+// rst: .. function:: template<typename GenPtrIter, typename ValueType, template<typename> class InOrbitHandlerT, typename OnNewElement, typename OnDupElement> \
+// rst:               void orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, Orbit<ValueType, InOrbitHandlerT> &workspace, OnNewElement onNewElement, OnDupElement onDupElement)
+// rst:
+// rst:		As the other `orbit` overloads, but the orbit is calculated in `workspace`,
+// rst:		which is cleared first and afterwards holds the orbit.
+// rst:		Use it, e.g., with an `orbit_workspace`, when calculating many orbits.
+
+template<typename GenPtrIter, typename ValueType, template<typename> class InOrbitHandlerT, typename OnNewElement, typename OnDupElement>
+void orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, Orbit<ValueType, InOrbitHandlerT> &workspace,
+		OnNewElement onNewElement, OnDupElement onDupElement) {
+	onNewElement(w, w, last);
+	workspace.clear(w);
+	workspace.update(first, first, last, onNewElement, onDupElement);
+}
+
 // rst: .. function:: template<typename Group, typename Callback> \
 // rst:               void orbit(std::size_t w, const Group &g, Callback callback)
 // rst:
@@ -0,0 +1,275 @@
+#ifndef PERM_GROUP_ORBIT_ACTION_HPP
+#define PERM_GROUP_ORBIT_ACTION_HPP
+
+#include <perm_group/permutation/permutation.hpp>
+#include <perm_group/permutation/word.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: action_on_points
+// rst:
+// rst:		The natural action on points.
+// rst:
+// rst:		.. function:: template<typename Perm, typename Point> \
+// rst:		              Point operator()(const Perm &p, Point u) const
+
+struct action_on_points {
+
+	template<typename Perm, typename Point>
+	Point operator()(const Perm &p, Point u) const {
+		return perm_group::get(p, u);
+	}
+};
+
+// rst: .. class:: action_on_tuples
+// rst:
+// rst:		The action on ordered tuples of points, e.g., a `std::vector` or `std::array`,
+// rst:		where each entry is mapped by the permutation.
+// rst:
+// rst:		.. function:: template<typename Perm, typename Tuple> \
+// rst:		              Tuple operator()(const Perm &p, const Tuple &t) const
+
+struct action_on_tuples {
+
+	template<typename Perm, typename Tuple>
+	Tuple operator()(const Perm &p, const Tuple &t) const {
+		Tuple res = t;
+		for(auto &e : res) e = perm_group::get(p, e);
+		return res;
+	}
+};
+
+// rst: .. class:: action_on_sets
+// rst:
+// rst:		The action on sets of points, represented as sorted tuples, see `action_on_tuples`.
+// rst:		The images are sorted again, so each set has a single representation.
+// rst:
+// rst:		.. function:: template<typename Perm, typename Set> \
+// rst:		              Set operator()(const Perm &p, const Set &s) const
+
+struct action_on_sets {
+
+	template<typename Perm, typename Set>
+	Set operator()(const Perm &p, const Set &s) const {
+		Set res = action_on_tuples()(p, s);
+		std::sort(std::begin(res), std::end(res));
+		return res;
+	}
+};
+
+// rst: .. class:: action_on_colorings
+// rst:
+// rst:		The action on colorings of the points, i.e., a tuple with a color for each point,
+// rst:		where the color of point `i` is moved to point `p(i)`.
+// rst:
+// rst:		.. function:: template<typename Perm, typename Coloring> \
+// rst:		              Coloring operator()(const Perm &p, const Coloring &c) const
+
+struct action_on_colorings {
+
+	template<typename Perm, typename Coloring>
+	Coloring operator()(const Perm &p, const Coloring &c) const {
+		Coloring res = c;
+		for(std::size_t i = 0; i != c.size(); ++i)
+			res[perm_group::get(p, i)] = c[i];
+		return res;
+	}
+};
+
+// rst: .. class:: template<typename Object, typename Hash = boost::hash<Object>, typename Equal = std::equal_to<Object> > \
+// rst:            action_orbit
+// rst:
+// rst:		The orbit of an object under a group acting on objects through an action functor,
+// rst:		`act(p, x)` being the image of `x` under the permutation `p`,
+// rst:		e.g., `action_on_points`, `action_on_tuples`, `action_on_sets`, or `action_on_colorings`.
+// rst:		This avoids constructing the induced permutation group on all objects.
+// rst:
+// rst:		The objects are stored contiguously in the order they were found,
+// rst:		and the visited objects are looked up in an open-addressing hash table of their positions.
+// rst:		For each object the Schreier tree is stored, as the position of the object it was found from
+// rst:		and the index of the generator that maps between them.
+// rst:
+
+template<typename Object, typename Hash = boost::hash<Object>, typename Equal = std::equal_to<Object> >
+struct action_orbit {
+	using object_type = Object;
+	using const_iterator = typename std::vector<Object>::const_iterator;
+	// rst:		.. var:: static constexpr std::size_t npos = -1
+	static constexpr std::size_t npos = -1;
+public:
+
+	// rst:		.. function:: explicit action_orbit(Hash hash = Hash(), Equal equal = Equal())
+	// rst:
+	// rst:			Construct an empty orbit.
+
+	explicit action_orbit(Hash hash = Hash(), Equal equal = Equal()) : hash(hash), equal(equal) { }
+
+	// rst:		.. function:: template<typename GenPtrIter, typename Action> \
+	// rst:		              void compute(const Object &w, GenPtrIter first, GenPtrIter last, Action act)
+	// rst:
+	// rst:			Replace the orbit with the orbit of `w` under the generators `first` to `last`,
+	// rst:			found with a breadth-first search, where the generators are tried in order.
+
+	template<typename GenPtrIter, typename Action>
+	void compute(const Object &w, GenPtrIter first, GenPtrIter last, Action act) {
+		objects.clear();
+		hashes.clear();
+		parents.clear();
+		labels.clear();
+		if(slots.empty()) slots.assign(16, npos);
+		else std::fill(slots.begin(), slots.end(), npos);
+		add(w, hash(w), npos, npos);
+		slots[find(objects[0], hashes[0])] = 0;
+		for(std::size_t i = 0; i != objects.size(); ++i) {
+			std::size_t gen = 0;
+			for(GenPtrIter it = first; it != last; ++it, ++gen) {
+				// computed before adding, as adding may move the objects
+				Object img = act(**it, objects[i]);
+				const std::size_t h = hash(img);
+				if(objects.size() * 2 >= slots.size()) grow();
+				const std::size_t slot = find(img, h);
+				if(slots[slot] != npos) continue;
+				slots[slot] = objects.size();
+				add(std::move(img), h, i, gen);
+			}
+		}
+	}
+
+	// rst:		.. function:: std::size_t size() const
+	// rst:		              const_iterator begin() const
+	// rst:		              const_iterator end() const
+	// rst:		              const Object &operator[](std::size_t i) const
+	// rst:
+	// rst:			The orbit elements in the order they were found, starting with the initial object.
+
+	std::size_t size() const {
+		return objects.size();
+	}
+
+	const_iterator begin() const {
+		return objects.begin();
+	}
+
+	const_iterator end() const {
+		return objects.end();
+	}
+
+	const Object &operator[](std::size_t i) const {
+		return objects[i];
+	}
+
+	// rst:		.. function:: std::size_t position(const Object &x) const
+	// rst:
+	// rst:			:returns: the position of `x` in the orbit, or `npos` if it is not in the orbit.
+
+	std::size_t position(const Object &x) const {
+		if(slots.empty()) return npos;
+		return slots[find(x, hash(x))];
+	}
+
+	// rst:		.. function:: bool contains(const Object &x) const
+
+	bool contains(const Object &x) const {
+		return position(x) != npos;
+	}
+
+	// rst:		.. function:: std::size_t parent(std::size_t i) const
+	// rst:		              std::size_t label(std::size_t i) const
+	// rst:
+	// rst:			:returns: the position of the object that element `i` was found from,
+	// rst:				and the index of the generator mapping that object to element `i`.
+	// rst:				Both are `npos` for the initial object.
+
+	std::size_t parent(std::size_t i) const {
+		return parents[i];
+	}
+
+	std::size_t label(std::size_t i) const {
+		return labels[i];
+	}
+
+	// rst:		.. function:: std::vector<std::size_t> labels_to(std::size_t i) const
+	// rst:
+	// rst:			:returns: the generator indices on the path in the Schreier tree from the initial object to element `i`,
+	// rst:				i.e., applying the generators in this order maps the initial object to element `i`.
+
+	std::vector<std::size_t> labels_to(std::size_t i) const {
+		std::vector<std::size_t> res;
+		for(; parents[i] != npos; i = parents[i])
+			res.push_back(labels[i]);
+		std::reverse(res.begin(), res.end());
+		return res;
+	}
+
+	// rst:		.. function:: template<typename GenPtrIter> \
+	// rst:		              permutation_word<Pointer> word_to(std::size_t i, GenPtrIter first) const
+	// rst:
+	// rst:			:returns: the group element mapping the initial object to element `i`,
+	// rst:				as a word of pointers to the generators from `first`, which must be the ones used in `compute`.
+	// rst:				The `Pointer` type is the value type of `GenPtrIter`.
+
+	template<typename GenPtrIter>
+	auto word_to(std::size_t i, GenPtrIter first) const {
+		using Pointer = typename std::iterator_traits<GenPtrIter>::value_type;
+		permutation_word<Pointer> res;
+		for(const std::size_t gen : labels_to(i))
+			res.push_back(*std::next(first, gen));
+		return res;
+	}
+private:
+
+	void add(Object x, std::size_t h, std::size_t parent, std::size_t label) {
+		objects.push_back(std::move(x));
+		hashes.push_back(h);
+		parents.push_back(parent);
+		labels.push_back(label);
+	}
+
+	std::size_t find(const Object &x, std::size_t h) const {
+		const std::size_t mask = slots.size() - 1;
+		std::size_t slot = (static_cast<std::uint64_t> (h) * 0x9E3779B97F4A7C15ull >> 32) & mask;
+		while(slots[slot] != npos && !(hashes[slots[slot]] == h && equal(objects[slots[slot]], x)))
+			slot = (slot + 1) & mask;
+		return slot;
+	}
+
+	void grow() {
+		slots.assign(2 * slots.size(), npos);
+		for(std::size_t i = 0; i != objects.size(); ++i)
+			slots[find(objects[i], hashes[i])] = i;
+	}
+private:
+	Hash hash;
+	Equal equal;
+	std::vector<Object> objects;
+	std::vector<std::size_t> hashes, parents, labels;
+	std::vector<std::size_t> slots;
+};
+
+template<typename Object, typename Hash, typename Equal>
+constexpr std::size_t action_orbit<Object, Hash, Equal>::npos;
+
+// rst: .. function:: template<typename Object, typename GenPtrIter, typename Action> \
+// rst:               action_orbit<Object> make_action_orbit(const Object &w, GenPtrIter first, GenPtrIter last, Action act)
+// rst:
+// rst:		:returns: the orbit of `w` under the generators `first` to `last` with the action `act`, see `action_orbit`.
+
+template<typename Object, typename GenPtrIter, typename Action>
+action_orbit<Object> make_action_orbit(const Object &w, GenPtrIter first, GenPtrIter last, Action act) {
+	action_orbit<Object> res;
+	res.compute(w, first, last, act);
+	return res;
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ORBIT_ACTION_HPP */
@@ -0,0 +1,165 @@
+#ifndef PERM_GROUP_ORBIT_BIDIRECTIONAL_HPP
+#define PERM_GROUP_ORBIT_BIDIRECTIONAL_HPP
+
+#include <perm_group/permutation/permutation.hpp>
+#include <perm_group/permutation/word.hpp>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace perm_group {
+namespace detail {
+
+template<typename ValueType>
+struct bidirectional_side {
+	static constexpr std::size_t root = -1;
+	// for each visited point, the point it was found from and the generator index,
+	// where the generator maps the forward parent to the point, and the point to the backward parent
+	std::unordered_map<ValueType, std::pair<ValueType, std::size_t> > parent;
+	std::vector<ValueType> frontier;
+public:
+
+	explicit bidirectional_side(ValueType w) : frontier(1, w) {
+		parent.emplace(w, std::make_pair(w, root));
+	}
+};
+
+template<typename ValueType>
+constexpr std::size_t bidirectional_side<ValueType>::root;
+
+// returns the generator indices of a word mapping u to v, applied in order
+template<typename ValueType, typename GenPtrIter, typename InvPtrIter>
+boost::optional<std::vector<std::size_t> > bidirectional_search(ValueType u, ValueType v,
+		GenPtrIter first, GenPtrIter last, InvPtrIter invFirst) {
+	using Side = bidirectional_side<ValueType>;
+	if(u == v) return std::vector<std::size_t>();
+	Side fwd(u), bwd(v);
+	const auto path = [&](ValueType meet) {
+		std::vector<std::size_t> res;
+		for(ValueType x = meet; fwd.parent.at(x).second != Side::root; x = fwd.parent.at(x).first)
+			res.push_back(fwd.parent.at(x).second);
+		std::reverse(res.begin(), res.end());
+		for(ValueType x = meet; bwd.parent.at(x).second != Side::root; x = bwd.parent.at(x).first)
+			res.push_back(bwd.parent.at(x).second);
+		return res;
+	};
+	// if one side runs out, it has enumerated its whole orbit without meeting the other
+	while(!fwd.frontier.empty() && !bwd.frontier.empty()) {
+		// expand a level of the side with the smallest frontier, with the inverses for the backward side
+		const bool forward = fwd.frontier.size() <= bwd.frontier.size();
+		Side &side = forward ? fwd : bwd;
+		const Side &other = forward ? bwd : fwd;
+		std::vector<ValueType> next;
+		for(const ValueType x : side.frontier) {
+			std::size_t gen = 0;
+			auto invIt = invFirst;
+			for(auto it = first; it != last; ++it, ++invIt, ++gen) {
+				const ValueType y = forward ? perm_group::get(**it, x) : perm_group::get(**invIt, x);
+				if(!side.parent.emplace(y, std::make_pair(x, gen)).second) continue;
+				if(other.parent.count(y)) return path(y);
+				next.push_back(y);
+			}
+		}
+		side.frontier.swap(next);
+	}
+	return boost::none;
+}
+
+template<typename GenPtrIter>
+using gen_ptr_value_type = typename permutation_traits<typename std::pointer_traits<
+/**/ typename std::iterator_traits<GenPtrIter>::value_type>::element_type>::value_type;
+
+template<typename GenPtrIter>
+std::vector<std::vector<gen_ptr_value_type<GenPtrIter> > > make_inverses(GenPtrIter first, GenPtrIter last) {
+	std::vector<std::vector<gen_ptr_value_type<GenPtrIter> > > res;
+	for(; first != last; ++first) {
+		const std::size_t n = perm_group::degree(**first);
+		res.emplace_back(n);
+		for(std::size_t i = 0; i != n; ++i)
+			res.back()[perm_group::get(**first, i)] = i;
+	}
+	return res;
+}
+
+template<typename T>
+std::vector<const T*> make_pointers(const std::vector<T> &ts) {
+	std::vector<const T*> res;
+	for(const T &t : ts) res.push_back(&t);
+	return res;
+}
+
+} // namespace detail
+
+// rst: .. function:: template<typename GenPtrIter, typename InvPtrIter> \
+// rst:               boost::optional<permutation_word<Pointer> > find_element_mapping(value_type u, value_type v, GenPtrIter first, GenPtrIter last, InvPtrIter invFirst)
+// rst:               template<typename GenPtrIter> \
+// rst:               boost::optional<permutation_word<Pointer> > find_element_mapping(value_type u, value_type v, GenPtrIter first, GenPtrIter last)
+// rst:
+// rst:		Search for an element of the group generated by `first` to `last` which maps `u` to `v`,
+// rst:		with a bidirectional breadth-first search from `u` with the generators and from `v` with their inverses,
+// rst:		starting from `invFirst`, in the same order as the generators.
+// rst:		Each round expands the side with the smallest frontier, and the search stops as soon as the two sides meet.
+// rst:		When `v` is close to `u` this visits a small part of the orbit,
+// rst:		and the visited points are stored in hash maps, so the memory use follows the visited points.
+// rst:		The overload without inverses first computes them, in :math:`O(n)` time per generator,
+// rst:		which requires `DegreeAwarePermutation`.
+// rst:		The `value_type` is the one of the permutations, and `Pointer` is the value type of `GenPtrIter`.
+// rst:
+// rst:		:returns: a word of pointers to the generators, which maps `u` to `v`,
+// rst:			or `boost::none` if `v` is not in the orbit of `u`.
+// rst:			The word only contains the generators, not their inverses, and it can be turned into a permutation with `materialize`.
+
+template<typename GenPtrIter, typename InvPtrIter>
+auto find_element_mapping(detail::gen_ptr_value_type<GenPtrIter> u, detail::gen_ptr_value_type<GenPtrIter> v,
+		GenPtrIter first, GenPtrIter last, InvPtrIter invFirst) {
+	using Pointer = typename std::iterator_traits<GenPtrIter>::value_type;
+	boost::optional<permutation_word<Pointer> > res;
+	const auto labels = detail::bidirectional_search(u, v, first, last, invFirst);
+	if(!labels) return res;
+	res.emplace();
+	for(const std::size_t gen : *labels)
+		res->push_back(*std::next(first, gen));
+	return res;
+}
+
+template<typename GenPtrIter>
+auto find_element_mapping(detail::gen_ptr_value_type<GenPtrIter> u, detail::gen_ptr_value_type<GenPtrIter> v,
+		GenPtrIter first, GenPtrIter last) {
+	const auto inverses = detail::make_inverses(first, last);
+	const auto invPtrs = detail::make_pointers(inverses);
+	return find_element_mapping(u, v, first, last, invPtrs.begin());
+}
+
+// rst: .. function:: template<typename GenPtrIter, typename InvPtrIter> \
+// rst:               bool same_orbit(value_type u, value_type v, GenPtrIter first, GenPtrIter last, InvPtrIter invFirst)
+// rst:               template<typename GenPtrIter> \
+// rst:               bool same_orbit(value_type u, value_type v, GenPtrIter first, GenPtrIter last)
+// rst:
+// rst:		:returns: whether `v` is in the orbit of `u` under the group generated by `first` to `last`,
+// rst:			found with the search of `find_element_mapping`.
+
+template<typename GenPtrIter, typename InvPtrIter>
+bool same_orbit(detail::gen_ptr_value_type<GenPtrIter> u, detail::gen_ptr_value_type<GenPtrIter> v,
+		GenPtrIter first, GenPtrIter last, InvPtrIter invFirst) {
+	return bool(detail::bidirectional_search(u, v, first, last, invFirst));
+}
+
+template<typename GenPtrIter>
+bool same_orbit(detail::gen_ptr_value_type<GenPtrIter> u, detail::gen_ptr_value_type<GenPtrIter> v,
+		GenPtrIter first, GenPtrIter last) {
+	if(u == v) return true;
+	const auto inverses = detail::make_inverses(first, last);
+	const auto invPtrs = detail::make_pointers(inverses);
+	return same_orbit(u, v, first, last, invPtrs.begin());
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ORBIT_BIDIRECTIONAL_HPP */
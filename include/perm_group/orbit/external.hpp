@@ -0,0 +1,380 @@
+#ifndef PERM_GROUP_ORBIT_EXTERNAL_HPP
+#define PERM_GROUP_ORBIT_EXTERNAL_HPP
+
+#include <perm_group/io.hpp>
+#include <perm_group/orbit/action.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: external_orbit_options
+// rst:
+// rst:		Options for `external_orbit`.
+// rst:
+
+struct external_orbit_options {
+	// rst:		.. var:: std::string directory
+	// rst:
+	// rst:			An existing directory for the files, which should not be shared with another orbit.
+	std::string directory;
+	// rst:		.. var:: std::size_t memory_limit = 64 << 20
+	// rst:
+	// rst:			The number of bytes used for buffering images before they are sorted and written as a run file.
+	std::size_t memory_limit = 64 << 20;
+	// rst:		.. var:: std::size_t max_merge_fan_in = 64
+	// rst:
+	// rst:			The maximum number of run files merged at once, and thus open at once.
+	// rst:			If a level has more runs, they are merged in several passes.
+	std::size_t max_merge_fan_in = 64;
+};
+
+namespace detail {
+
+struct external_file {
+
+	external_file(std::string path, const char *mode) : path(std::move(path)), f(std::fopen(this->path.c_str(), mode)) {
+		if(!f) fail("Could not open");
+	}
+
+	external_file(const external_file&) = delete;
+	external_file &operator=(const external_file&) = delete;
+
+	~external_file() {
+		if(f) std::fclose(f);
+	}
+
+	template<typename T>
+	bool read(T &x) {
+		return std::fread(&x, sizeof(T), 1, f) == 1;
+	}
+
+	template<typename T>
+	void write(const T *first, std::size_t count) {
+		if(std::fwrite(first, sizeof(T), count, f) != count) fail("Could not write to");
+	}
+
+	template<typename T>
+	void write(const T &x) {
+		write(&x, 1);
+	}
+
+	void close() {
+		const int res = std::fclose(f);
+		f = nullptr;
+		if(res != 0) fail("Could not close");
+	}
+private:
+
+	void fail(const char *what) const {
+		throw io_error(std::string(what) + " '" + path + "': " + std::strerror(errno));
+	}
+private:
+	std::string path;
+	std::FILE *f;
+};
+
+} // namespace detail
+
+// rst: .. class:: template<typename Object, typename Less = std::less<Object> > \
+// rst:            external_orbit
+// rst:
+// rst:		An orbit that is kept on disk instead of in memory, for orbits with more elements than fit in memory.
+// rst:		The `Object` type must be trivially copyable, e.g., an integer for the action on points,
+// rst:		or a `std::array` for the action on tuples, as objects are stored as raw records.
+// rst:		The action functor is as for `action_orbit`.
+// rst:
+// rst:		The orbit is computed with a breadth-first search, one level at a time.
+// rst:		The images of the current level are collected in a buffer bounded by `external_orbit_options::memory_limit`,
+// rst:		which is sorted and written as a run file whenever it is full.
+// rst:		The runs are then merged with the sorted file of all elements found so far,
+// rst:		which removes the duplicates and produces the next level and the new file of all elements.
+// rst:		If there are more runs than `external_orbit_options::max_merge_fan_in`,
+// rst:		groups of them are first merged into longer runs, until few enough are left.
+// rst:		The memory use and the number of open files are thus bounded by the options.
+// rst:
+// rst:		After each level a checkpoint is written to the directory,
+// rst:		and constructing an orbit on a directory with a checkpoint resumes from it.
+// rst:		The checkpoint records the size of `Object`, and a checkpoint with another record size is rejected.
+// rst:		The files of a level are only removed after the checkpoint of the next level is written,
+// rst:		so an interrupted computation can always be resumed.
+// rst:
+
+template<typename Object, typename Less = std::less<Object> >
+struct external_orbit {
+	static_assert(std::is_trivially_copyable<Object>::value, "The objects are stored as raw records.");
+	using object_type = Object;
+public:
+
+	// rst:		.. function:: explicit external_orbit(external_orbit_options opts, Less less = Less())
+	// rst:
+	// rst:			Construct an orbit using the given directory.
+	// rst:			If the directory has a checkpoint it is loaded, otherwise the orbit is empty and `start` must be called.
+	// rst:
+	// rst:			:throws: `io_error` if the checkpoint can not be parsed, or if it is for objects of another size.
+
+	explicit external_orbit(external_orbit_options opts, Less less = Less()) : opts(std::move(opts)), less(less) {
+		std::ifstream state(file("state"));
+		if(!state) return;
+		std::string tag;
+		std::size_t recordSize;
+		if(!(state >> tag >> recordSize >> level_ >> size_ >> frontier_size_) || tag != "external_orbit")
+			throw io_error("Could not parse checkpoint '" + file("state") + "'.");
+		if(recordSize != sizeof(Object))
+			throw io_error("Checkpoint '" + file("state") + "' has records of " + std::to_string(recordSize)
+				+ " bytes, but the objects have " + std::to_string(sizeof(Object)) + " bytes.");
+		resumed_ = true;
+	}
+
+	// rst:		.. function:: bool resumed() const
+	// rst:
+	// rst:			:returns: whether a checkpoint was loaded by the constructor.
+
+	bool resumed() const {
+		return resumed_;
+	}
+
+	// rst:		.. function:: void start(const Object &w)
+	// rst:
+	// rst:			Start a new orbit with the single element `w`, discarding any existing orbit.
+
+	void start(const Object &w) {
+		if(resumed_ || size_ != 0) remove_level(level_);
+		level_ = 0;
+		size_ = frontier_size_ = 1;
+		detail::external_file(level_file("visited", 0), "wb").write(w);
+		detail::external_file(level_file("frontier", 0), "wb").write(w);
+		write_checkpoint();
+	}
+
+	// rst:		.. function:: template<typename GenPtrIter, typename Action> \
+	// rst:		              bool step(GenPtrIter first, GenPtrIter last, Action act)
+	// rst:
+	// rst:			Find the next level of the breadth-first search with the generators `first` to `last`, and write a checkpoint.
+	// rst:			The generators must be the same in each call, also when resuming.
+	// rst:
+	// rst:			:returns: `false` if the orbit is complete.
+	// rst:			:throws: `io_error` if a file can not be read or written.
+
+	template<typename GenPtrIter, typename Action>
+	bool step(GenPtrIter first, GenPtrIter last, Action act) {
+		if(frontier_size_ == 0) return false;
+		std::vector<std::string> runs = write_runs(first, last, act);
+		reduce_runs(runs);
+		merge_runs(runs);
+		++level_;
+		write_checkpoint();
+		remove_level(level_ - 1);
+		for(const auto &r : runs)
+			std::remove(r.c_str());
+		return frontier_size_ != 0;
+	}
+
+	// rst:		.. function:: template<typename GenPtrIter, typename Action> \
+	// rst:		              void run(GenPtrIter first, GenPtrIter last, Action act)
+	// rst:
+	// rst:			Call `step` until the orbit is complete.
+
+	template<typename GenPtrIter, typename Action>
+	void run(GenPtrIter first, GenPtrIter last, Action act) {
+		while(step(first, last, act));
+	}
+
+	// rst:		.. function:: bool done() const
+	// rst:
+	// rst:			:returns: whether the orbit is complete.
+
+	bool done() const {
+		return frontier_size_ == 0;
+	}
+
+	// rst:		.. function:: std::size_t size() const
+	// rst:		              std::size_t frontier_size() const
+	// rst:		              std::size_t level() const
+	// rst:
+	// rst:			:returns: the number of elements found so far, the number of elements found in the last level,
+	// rst:				and the number of completed levels.
+
+	std::size_t size() const {
+		return size_;
+	}
+
+	std::size_t frontier_size() const {
+		return frontier_size_;
+	}
+
+	std::size_t level() const {
+		return level_;
+	}
+
+	// rst:		.. function:: template<typename F> void for_each(F f) const
+	// rst:		              template<typename F> void for_each_in_frontier(F f) const
+	// rst:
+	// rst:			Call `f(x)` for each element `x` found so far, or found in the last level, in sorted order.
+	// rst:			The elements are streamed from disk.
+
+	template<typename F>
+	void for_each(F f) const {
+		for_each_in(level_file("visited", level_), f);
+	}
+
+	template<typename F>
+	void for_each_in_frontier(F f) const {
+		for_each_in(level_file("frontier", level_), f);
+	}
+private:
+
+	std::string file(const std::string &name) const {
+		return opts.directory + "/" + name;
+	}
+
+	std::string level_file(const char *name, std::size_t level) const {
+		return file(name + std::string("_") + std::to_string(level));
+	}
+
+	std::string run_file(std::size_t r) const {
+		return file("run_" + std::to_string(r));
+	}
+
+	template<typename F>
+	void for_each_in(const std::string &path, F &f) const {
+		detail::external_file in(path, "rb");
+		Object x;
+		while(in.read(x)) f(static_cast<const Object&> (x));
+	}
+
+	void write_checkpoint() const {
+		{
+			std::ofstream state(file("state.tmp"));
+			state << "external_orbit " << sizeof(Object) << " " << level_ << " " << size_ << " " << frontier_size_ << "\n";
+			if(!(state << std::flush))
+				throw io_error("Could not write checkpoint '" + file("state.tmp") + "'.");
+		}
+		if(std::rename(file("state.tmp").c_str(), file("state").c_str()) != 0)
+			throw io_error("Could not write checkpoint '" + file("state") + "': " + std::strerror(errno));
+	}
+
+	void remove_level(std::size_t level) const {
+		std::remove(level_file("visited", level).c_str());
+		std::remove(level_file("frontier", level).c_str());
+	}
+
+	template<typename GenPtrIter, typename Action>
+	std::vector<std::string> write_runs(GenPtrIter first, GenPtrIter last, Action &act) {
+		const std::size_t capacity = std::max<std::size_t>(1, opts.memory_limit / sizeof(Object));
+		std::vector<Object> buffer;
+		buffer.reserve(capacity);
+		std::vector<std::string> runs;
+		const auto flush = [&]() {
+			std::sort(buffer.begin(), buffer.end(), less);
+			buffer.erase(std::unique(buffer.begin(), buffer.end(), [this](const Object &a, const Object &b) {
+				return !less(a, b) && !less(b, a);
+			}), buffer.end());
+			runs.push_back(run_file(runs.size()));
+			detail::external_file out(runs.back(), "wb");
+			out.write(buffer.data(), buffer.size());
+			out.close();
+			buffer.clear();
+		};
+		for_each_in_frontier([&](const Object &x) {
+			for(GenPtrIter it = first; it != last; ++it) {
+				if(buffer.size() == capacity) flush();
+				buffer.push_back(act(**it, x));
+			}
+		});
+		if(!buffer.empty()) flush();
+		return runs;
+	}
+
+	// calls out(x) for each distinct object x in the sorted runs, in sorted order
+	template<typename Out>
+	void merge(std::vector<std::string>::const_iterator first, std::vector<std::string>::const_iterator last, Out out) const {
+		std::vector<std::unique_ptr<detail::external_file> > runs;
+		using Entry = std::pair<Object, std::size_t>;
+		const auto greater = [this](const Entry &a, const Entry &b) {
+			return less(b.first, a.first);
+		};
+		std::priority_queue<Entry, std::vector<Entry>, decltype(greater)> heads(greater);
+		for(; first != last; ++first) {
+			runs.emplace_back(new detail::external_file(*first, "rb"));
+			Object x;
+			if(runs.back()->read(x)) heads.emplace(x, runs.size() - 1);
+		}
+		Object prev;
+		bool hasPrev = false;
+		while(!heads.empty()) {
+			const Entry e = heads.top();
+			heads.pop();
+			Object next;
+			if(runs[e.second]->read(next)) heads.emplace(next, e.second);
+			if(hasPrev && !less(prev, e.first)) continue; // a duplicate from another run
+			prev = e.first;
+			hasPrev = true;
+			out(e.first);
+		}
+	}
+
+	// merge groups of runs until at most max_merge_fan_in are left
+	void reduce_runs(std::vector<std::string> &runs) const {
+		const std::size_t fanIn = std::max<std::size_t>(2, opts.max_merge_fan_in);
+		for(std::size_t pass = 0; runs.size() > fanIn; ++pass) {
+			std::vector<std::string> merged;
+			for(std::size_t i = 0; i < runs.size(); i += fanIn) {
+				const auto first = runs.begin() + i;
+				const auto last = runs.begin() + std::min(i + fanIn, runs.size());
+				merged.push_back(file("run_" + std::to_string(pass) + "_" + std::to_string(merged.size())));
+				detail::external_file out(merged.back(), "wb");
+				merge(first, last, [&out](const Object &x) {
+					out.write(x);
+				});
+				out.close();
+				for(auto it = first; it != last; ++it)
+					std::remove(it->c_str());
+			}
+			runs.swap(merged);
+		}
+	}
+
+	void merge_runs(const std::vector<std::string> &runs) {
+		detail::external_file visited(level_file("visited", level_), "rb");
+		detail::external_file newVisited(level_file("visited", level_ + 1), "wb");
+		detail::external_file newFrontier(level_file("frontier", level_ + 1), "wb");
+		Object v;
+		bool hasV = visited.read(v);
+		std::size_t count = 0;
+		merge(runs.begin(), runs.end(), [&](const Object &x) {
+			for(; hasV && less(v, x); hasV = visited.read(v))
+				newVisited.write(v);
+			if(hasV && !less(x, v)) return; // found in an earlier level
+			newVisited.write(x);
+			newFrontier.write(x);
+			++count;
+		});
+		for(; hasV; hasV = visited.read(v))
+			newVisited.write(v);
+		newVisited.close();
+		newFrontier.close();
+		size_ += count;
+		frontier_size_ = count;
+	}
+private:
+	external_orbit_options opts;
+	Less less;
+	bool resumed_ = false;
+	std::size_t level_ = 0, size_ = 0, frontier_size_ = 0;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ORBIT_EXTERNAL_HPP */
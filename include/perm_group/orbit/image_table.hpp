@@ -0,0 +1,124 @@
+#ifndef PERM_GROUP_ORBIT_IMAGE_TABLE_HPP
+#define PERM_GROUP_ORBIT_IMAGE_TABLE_HPP
+
+#include <perm_group/permutation/permutation.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            generator_image_table
+// rst:
+// rst:		The images of all points under a list of generators, stored point-major,
+// rst:		i.e., the images of a point under all generators are contiguous.
+// rst:		Expanding a point in an orbit computation is then a single contiguous load,
+// rst:		instead of one load from each generator.
+// rst:		Each row has room for more generators, and the table is rebuilt with twice the room
+// rst:		when it runs out, so adding a generator takes amortized :math:`O(n)` time.
+// rst:
+// rst:		It can be kept in sync with a `generated_group` by passing it as the `next` callback:
+// rst:		``g.add_generator(p, std::ref(table))``.
+// rst:		See `Orbit::update` for using it.
+// rst:
+
+template<typename ValueType>
+struct generator_image_table {
+	using value_type = ValueType;
+public:
+
+	// rst:		.. function:: explicit generator_image_table(std::size_t n)
+	// rst:
+	// rst:			Construct an empty table for generators of degree `n`.
+
+	explicit generator_image_table(std::size_t n) : n(n) { }
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return n;
+	}
+
+	// rst:		.. function:: std::size_t num_generators() const
+
+	std::size_t num_generators() const {
+		return num;
+	}
+
+	// rst:		.. function:: template<typename Perm> void add_generator(const Perm &p)
+	// rst:
+	// rst:			Add the images of `p` as the last column.
+
+	template<typename Perm>
+	void add_generator(const Perm &p) {
+		if(num == stride) grow();
+		for(std::size_t i = 0; i != n; ++i)
+			table[i * stride + num] = perm_group::get(p, i);
+		++num;
+	}
+
+	// rst:		.. function:: template<typename GenPtrIter> \
+	// rst:		              void assign(GenPtrIter first, GenPtrIter last)
+	// rst:
+	// rst:			Replace the table with the images of the given generators.
+
+	template<typename GenPtrIter>
+	void assign(GenPtrIter first, GenPtrIter last) {
+		num = 0;
+		for(; first != last; ++first)
+			add_generator(**first);
+	}
+
+	// rst:		.. function:: template<typename GenPtrIter> \
+	// rst:		              void operator()(GenPtrIter first, GenPtrIter lastOld, GenPtrIter lastNew)
+	// rst:
+	// rst:			Add the new generators `lastOld` to `lastNew`, with the signature of the `next` callback of `generated_group`.
+	// rst:			If the table does not have a column for each generator from `first` to `lastOld`, it is rebuilt.
+
+	template<typename GenPtrIter>
+	void operator()(GenPtrIter first, GenPtrIter lastOld, GenPtrIter lastNew) {
+		if(static_cast<std::size_t> (std::distance(first, lastOld)) != num) {
+			assign(first, lastNew);
+		} else {
+			for(; lastOld != lastNew; ++lastOld)
+				add_generator(**lastOld);
+		}
+	}
+
+	// rst:		.. function:: const value_type *images(value_type u) const
+	// rst:
+	// rst:			:returns: a pointer to the `num_generators()` images of `u`.
+
+	const value_type *images(value_type u) const {
+		assert(u < n);
+		return table.data() + u * stride;
+	}
+
+	// rst:		.. function:: value_type image(value_type u, std::size_t gen) const
+
+	value_type image(value_type u, std::size_t gen) const {
+		assert(gen < num);
+		return images(u)[gen];
+	}
+private:
+
+	void grow() {
+		const std::size_t newStride = std::max<std::size_t>(4, 2 * stride);
+		std::vector<value_type> newTable(n * newStride);
+		for(std::size_t i = 0; i != n; ++i)
+			std::copy(table.begin() + i * stride, table.begin() + i * stride + num, newTable.begin() + i * newStride);
+		table.swap(newTable);
+		stride = newStride;
+	}
+private:
+	std::size_t n;
+	std::size_t num = 0, stride = 0;
+	std::vector<value_type> table;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ORBIT_IMAGE_TABLE_HPP */
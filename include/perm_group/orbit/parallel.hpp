@@ -0,0 +1,229 @@
+#ifndef PERM_GROUP_ORBIT_PARALLEL_HPP
+#define PERM_GROUP_ORBIT_PARALLEL_HPP
+
+#include <perm_group/permutation/permutation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: parallel_orbit_options
+// rst:
+// rst:		Options for `parallel_orbit`.
+// rst:
+
+struct parallel_orbit_options {
+	// rst:		.. var:: std::size_t num_threads = 0
+	// rst:
+	// rst:			The number of threads to use, where 0 means ``std::thread::hardware_concurrency()``.
+	std::size_t num_threads = 0;
+	// rst:		.. var:: bool deterministic = false
+	// rst:
+	// rst:			If `true`, the orbit elements and the callbacks come in the same order as from `orbit`,
+	// rst:			regardless of the number of threads.
+	// rst:			This requires a sequential pass over all images of each BFS level.
+	// rst:			Otherwise the order within each BFS level depends on the thread scheduling.
+	bool deterministic = false;
+	// rst:		.. var:: std::size_t min_parallel_frontier = 4096
+	// rst:
+	// rst:			BFS levels with fewer points than this are expanded by the calling thread alone.
+	std::size_t min_parallel_frontier = 4096;
+};
+
+namespace detail {
+
+struct atomic_bitset {
+	explicit atomic_bitset(std::size_t n) : bits(new std::atomic<std::uint64_t>[(n + 63) / 64]) {
+		for(std::size_t i = 0; i != (n + 63) / 64; ++i)
+			bits[i].store(0, std::memory_order_relaxed);
+	}
+
+	bool test(std::size_t i) const {
+		return (bits[i / 64].load(std::memory_order_relaxed) >> (i % 64)) & 1;
+	}
+
+	// returns the old value
+	bool test_and_set(std::size_t i) {
+		const std::uint64_t mask = std::uint64_t(1) << (i % 64);
+		return bits[i / 64].fetch_or(mask, std::memory_order_relaxed) & mask;
+	}
+private:
+	std::unique_ptr<std::atomic<std::uint64_t>[] > bits;
+};
+
+// Workers for expand(t) with t from 1 to numThreads - 1, which are started once and wait for each level.
+struct parallel_orbit_pool {
+
+	template<typename Expand>
+	parallel_orbit_pool(std::size_t numThreads, const Expand &expand) : expand(expand) {
+		for(std::size_t t = 1; t != numThreads; ++t)
+			workers.emplace_back([this, t]() {
+				work(t);
+			});
+	}
+
+	~parallel_orbit_pool() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		start.notify_all();
+		for(auto &worker : workers) worker.join();
+	}
+
+	// run expand(t) for t from 0 to threads - 1, where the calling thread takes 0
+	void run(std::size_t threads) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			active = threads;
+			pending = threads - 1;
+			++generation;
+		}
+		start.notify_all();
+		expand(0);
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]() {
+			return pending == 0;
+		});
+	}
+private:
+
+	void work(std::size_t t) {
+		std::size_t seen = 0;
+		while(true) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				start.wait(lock, [&]() {
+					return stop || generation != seen;
+				});
+				if(stop) return;
+				seen = generation;
+				if(t >= active) continue;
+			}
+			expand(t);
+			std::lock_guard<std::mutex> lock(mutex);
+			if(--pending == 0) done.notify_one();
+		}
+	}
+private:
+	std::function<void(std::size_t) > expand;
+	std::vector<std::thread> workers;
+	std::mutex mutex;
+	std::condition_variable start, done;
+	std::size_t generation = 0, active = 0, pending = 0;
+	bool stop = false;
+};
+
+template<typename ValueType>
+struct parallel_orbit_found {
+	ValueType from;
+	std::size_t gen;
+	ValueType img;
+};
+
+} // namespace detail
+
+// rst: .. function:: template<typename GenPtrIter, typename OnNewElement> \
+// rst:               std::vector<value_type> parallel_orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, std::size_t n, const parallel_orbit_options &opts, OnNewElement onNewElement)
+// rst:               template<typename GenPtrIter> \
+// rst:               std::vector<value_type> parallel_orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, std::size_t n, const parallel_orbit_options &opts)
+// rst:
+// rst:		Calculate the orbit of `w` under the non-empty range of generators `first` to `last`,
+// rst:		with a breadth-first search where each level is split between several threads.
+// rst:		The threads are started once, at the first level large enough to split, and wait between levels.
+// rst:		Points are marked in a shared atomic bitset, and each thread collects its new points in its own buffer.
+// rst:		The `value_type` is the one of the permutations.
+// rst:
+// rst:		After each level, `onNewElement(u, o, it)` is called from the calling thread for each new orbit element `o`,
+// rst:		as in `orbit`, including the initial call `onNewElement(w, w, last)`.
+// rst:		There is no `onDupElement`, as calling it for each image would serialize the search.
+// rst:		The overload without a callback only collects the orbit.
+// rst:
+// rst:		The permutations are only read, and must not be modified during the call.
+// rst:
+// rst:		:returns: the orbit elements in the order they were found.
+
+template<typename GenPtrIter, typename OnNewElement>
+auto parallel_orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, std::size_t n,
+		const parallel_orbit_options &opts, OnNewElement onNewElement) {
+	using PermPtr = typename std::iterator_traits<GenPtrIter>::value_type;
+	using Perm = typename std::pointer_traits<PermPtr>::element_type;
+	using value_type = typename permutation_traits<Perm>::value_type;
+	using Found = detail::parallel_orbit_found<value_type>;
+
+	std::vector<GenPtrIter> its;
+	std::vector<const Perm*> gens;
+	for(GenPtrIter it = first; it != last; ++it) {
+		its.push_back(it);
+		gens.push_back(&**it);
+	}
+	const std::size_t numThreads = opts.num_threads != 0
+			? opts.num_threads
+			: std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+	detail::atomic_bitset visited(n);
+	visited.test_and_set(w);
+	std::vector<value_type> orbit(1, w);
+	onNewElement(w, w, last);
+	std::vector<std::vector<Found> > buffers(numThreads);
+	std::size_t levelBegin = 0, levelEnd = 1, size = 1, threads = 1;
+	const auto expand = [&](std::size_t t) {
+		std::vector<Found> &buf = buffers[t];
+		buf.clear();
+		const std::size_t lo = levelBegin + size * t / threads;
+		const std::size_t hi = levelBegin + size * (t + 1) / threads;
+		for(std::size_t i = lo; i != hi; ++i) {
+			const value_type oi = orbit[i];
+			for(std::size_t g = 0; g != gens.size(); ++g) {
+				const value_type img = perm_group::get(*gens[g], oi);
+				// in deterministic mode the bitset is only written between levels,
+				// and the first finder in (position, generator) order is chosen afterwards
+				const bool seen = opts.deterministic ? visited.test(img) : visited.test_and_set(img);
+				if(!seen) buf.push_back(Found{oi, g, img});
+			}
+		}
+	};
+	// the workers are started at the first level large enough to split, and wait for each new level
+	std::unique_ptr<detail::parallel_orbit_pool> pool;
+	while(levelBegin != levelEnd) {
+		size = levelEnd - levelBegin;
+		threads = size < opts.min_parallel_frontier ? 1 : std::min(numThreads, size);
+		if(threads == 1) {
+			expand(0);
+		} else {
+			if(!pool) pool.reset(new detail::parallel_orbit_pool(numThreads, expand));
+			pool->run(threads);
+		}
+		// the chunks are in order, so concatenating the buffers keeps the sequential order
+		for(std::size_t t = 0; t != threads; ++t) {
+			for(const Found &f : buffers[t]) {
+				if(opts.deterministic && visited.test_and_set(f.img)) continue;
+				orbit.push_back(f.img);
+				onNewElement(f.from, f.img, its[f.gen]);
+			}
+		}
+		levelBegin = levelEnd;
+		levelEnd = orbit.size();
+	}
+	return orbit;
+}
+
+template<typename GenPtrIter>
+auto parallel_orbit(std::size_t w, const GenPtrIter &first, const GenPtrIter &last, std::size_t n,
+		const parallel_orbit_options &opts) {
+	return parallel_orbit(w, first, last, n, opts, [](auto&&... args) {
+	});
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ORBIT_PARALLEL_HPP */
@@ -0,0 +1,143 @@
+#ifndef PERM_GROUP_ORBIT_PARTITION_HPP
+#define PERM_GROUP_ORBIT_PARTITION_HPP
+
+#include <perm_group/permutation/permutation.hpp>
+
+#include <cassert>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType = std::size_t> \
+// rst:            orbit_partition
+// rst:
+// rst:		The partition of the points into orbits, maintained with a union-find structure.
+// rst:		Adding a generator of degree `n` costs :math:`O(n\alpha(n))`,
+// rst:		and all the queries take amortized :math:`O(\alpha(n))` time.
+// rst:		The queries compress paths, and the partition is therefore not safe to query concurrently.
+// rst:
+// rst:		It can be kept up to date with a `generated_group` by passing it as the `next` callback:
+// rst:		``g.add_generator(p, std::ref(partition))``.
+// rst:
+
+template<typename ValueType = std::size_t>
+struct orbit_partition {
+	using value_type = ValueType;
+public:
+
+	// rst:		.. function:: explicit orbit_partition(std::size_t n)
+	// rst:
+	// rst:			Construct the partition into singletons of `n` points, i.e., the orbits of the trivial group.
+
+	explicit orbit_partition(std::size_t n) : parent(n), size(n, 1), min(n), count(n) {
+		std::iota(parent.begin(), parent.end(), value_type());
+		std::iota(min.begin(), min.end(), value_type());
+	}
+
+	// rst:		.. function:: std::size_t degree() const
+
+	std::size_t degree() const {
+		return parent.size();
+	}
+
+	// rst:		.. function:: template<typename Perm> void add_generator(const Perm &p)
+	// rst:
+	// rst:			Merge the orbits such that each point is in the same orbit as its image under `p`.
+
+	template<typename Perm>
+	void add_generator(const Perm &p) {
+		for(std::size_t i = 0; i != degree(); ++i) {
+			const value_type img = perm_group::get(p, i);
+			if(img != i) unite(i, img);
+		}
+	}
+
+	// rst:		.. function:: template<typename GenPtrIter> \
+	// rst:		              void operator()(GenPtrIter first, GenPtrIter lastOld, GenPtrIter lastNew)
+	// rst:
+	// rst:			Add the new generators `lastOld` to `lastNew`, with the signature of the `next` callback of `generated_group`.
+
+	template<typename GenPtrIter>
+	void operator()(GenPtrIter first, GenPtrIter lastOld, GenPtrIter lastNew) {
+		for(; lastOld != lastNew; ++lastOld)
+			add_generator(**lastOld);
+	}
+
+	// rst:		.. function:: value_type representative(value_type u) const
+	// rst:
+	// rst:			:returns: the smallest point in the orbit of `u`.
+
+	value_type representative(value_type u) const {
+		return min[find(u)];
+	}
+
+	// rst:		.. function:: bool same_orbit(value_type u, value_type v) const
+
+	bool same_orbit(value_type u, value_type v) const {
+		return find(u) == find(v);
+	}
+
+	// rst:		.. function:: std::size_t orbit_size(value_type u) const
+
+	std::size_t orbit_size(value_type u) const {
+		return size[find(u)];
+	}
+
+	// rst:		.. function:: std::size_t num_orbits() const
+
+	std::size_t num_orbits() const {
+		return count;
+	}
+
+	// rst:		.. function:: std::vector<std::vector<value_type> > orbits() const
+	// rst:
+	// rst:			:returns: the orbits, each sorted, and ordered by their smallest points.
+
+	std::vector<std::vector<value_type> > orbits() const {
+		std::vector<std::vector<value_type> > res;
+		std::vector<std::size_t> index(degree(), -1);
+		for(std::size_t i = 0; i != degree(); ++i) {
+			const value_type r = find(i);
+			if(index[r] == std::size_t(-1)) {
+				index[r] = res.size();
+				res.emplace_back();
+				res.back().reserve(size[r]);
+			}
+			res[index[r]].push_back(i);
+		}
+		return res;
+	}
+private:
+
+	value_type find(value_type u) const {
+		assert(u < degree());
+		// path halving
+		while(parent[u] != u) {
+			parent[u] = parent[parent[u]];
+			u = parent[u];
+		}
+		return u;
+	}
+
+	void unite(value_type u, value_type v) {
+		u = find(u);
+		v = find(v);
+		if(u == v) return;
+		if(size[u] < size[v]) std::swap(u, v);
+		parent[v] = u;
+		size[u] += size[v];
+		if(min[v] < min[u]) min[u] = min[v];
+		--count;
+	}
+private:
+	mutable std::vector<value_type> parent;
+	std::vector<std::size_t> size;
+	std::vector<value_type> min;
+	std::size_t count;
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_ORBIT_PARTITION_HPP */
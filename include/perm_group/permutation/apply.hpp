@@ -0,0 +1,142 @@
+#ifndef PERM_GROUP_PERMUTATION_APPLY_HPP
+#define PERM_GROUP_PERMUTATION_APPLY_HPP
+
+#include <perm_group/permutation/materialize.hpp>
+#include <perm_group/permutation/permutation.hpp>
+#include <perm_group/util/simd.hpp>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace perm_group {
+namespace detail {
+
+template<typename Iter, typename ValueType>
+using is_pointer_to = std::integral_constant<bool, std::is_pointer<Iter>::value
+		&& std::is_same<typename std::remove_cv<typename std::remove_pointer<Iter>::type>::type, ValueType>::value>;
+
+// Whether the images can be gathered directly from the image array of the permutation.
+
+template<typename Perm, typename InputIterator, typename OutputIterator>
+using is_apply_gather = std::integral_constant<bool,
+		is_contiguous_as<Perm, typename permutation_traits<Perm>::value_type>::value
+		&& is_pointer_to<InputIterator, typename permutation_traits<Perm>::value_type>::value
+		&& is_pointer_to<OutputIterator, typename permutation_traits<Perm>::value_type>::value>;
+
+template<typename Perm, typename InputIterator, typename OutputIterator>
+OutputIterator apply(const Perm &p, InputIterator first, InputIterator last, OutputIterator out, std::true_type) {
+	const std::size_t len = last - first;
+	detail::gather(perm_group::contiguous_images(p), first, out, len);
+	return out + len;
+}
+
+template<typename Perm, typename InputIterator, typename OutputIterator>
+OutputIterator apply(const Perm &p, InputIterator first, InputIterator last, OutputIterator out, std::false_type) {
+	for(; first != last; ++first, ++out)
+		*out = perm_group::get(p, *first);
+	return out;
+}
+
+} // namespace detail
+
+// rst: Applying a permutation to many points at once.
+// rst: When the permutation has `contiguous_images` and the points are given as pointers to its `value_type`,
+// rst: the images are looked up with vectorized gathers when available.
+// rst:
+// rst: .. function:: template<typename Perm, typename InputIterator, typename OutputIterator> \
+// rst:               OutputIterator apply(const Perm &p, InputIterator first, InputIterator last, OutputIterator out)
+// rst:
+// rst:		Requires `Permutation<Perm>`.
+// rst:
+// rst:		Write the image under `p` of each element in the range `first` to `last` to `out`.
+// rst:		The output range may be the input range.
+// rst:
+// rst:		:returns: the output iterator after the last written image.
+
+template<typename Perm, typename InputIterator, typename OutputIterator>
+OutputIterator apply(const Perm &p, InputIterator first, InputIterator last, OutputIterator out) {
+	BOOST_CONCEPT_ASSERT((Permutation<Perm>));
+	return detail::apply(p, first, last, out, detail::is_apply_gather<Perm, InputIterator, OutputIterator>());
+}
+
+// rst: .. function:: template<typename Perm, typename ForwardIterator> \
+// rst:               void apply_inplace(const Perm &p, ForwardIterator first, ForwardIterator last)
+// rst:
+// rst:		Requires `Permutation<Perm>`.
+// rst:
+// rst:		Replace each element in the range `first` to `last` by its image under `p`.
+
+template<typename Perm, typename ForwardIterator>
+void apply_inplace(const Perm &p, ForwardIterator first, ForwardIterator last) {
+	perm_group::apply(p, first, last, first);
+}
+
+// rst: .. function:: template<typename Perm, typename InputIterator, typename OutputIterator> \
+// rst:               OutputIterator apply_sorted_set(const Perm &p, InputIterator first, InputIterator last, OutputIterator out)
+// rst:
+// rst:		Requires `Permutation<Perm>`.
+// rst:
+// rst:		Write the image under `p` of the set of elements in the range `first` to `last` to `out`,
+// rst:		in increasing order.
+// rst:
+// rst:		:returns: the output iterator after the last written image.
+
+template<typename Perm, typename InputIterator, typename OutputIterator>
+OutputIterator apply_sorted_set(const Perm &p, InputIterator first, InputIterator last, OutputIterator out) {
+	using value_type = typename permutation_traits<Perm>::value_type;
+	std::vector<value_type> images(first, last);
+	perm_group::apply_inplace(p, images.data(), images.data() + images.size());
+	std::sort(images.begin(), images.end());
+	return std::copy(images.begin(), images.end(), out);
+}
+
+// rst: .. function:: template<typename Perm, typename Block, typename Allocator> \
+// rst:               void apply_set(const Perm &p, const boost::dynamic_bitset<Block, Allocator> &set, boost::dynamic_bitset<Block, Allocator> &image)
+// rst:
+// rst:		Requires `Permutation<Perm>`.
+// rst:
+// rst:		Store the image under `p` of the set with the characteristic vector `set` in `image`,
+// rst:		which is resized to the size of `set`. The two bitsets must be different objects.
+// rst:		It takes time proportional to the number of blocks plus the size of the set.
+
+template<typename Perm, typename Block, typename Allocator>
+void apply_set(const Perm &p, const boost::dynamic_bitset<Block, Allocator> &set, boost::dynamic_bitset<Block, Allocator> &image) {
+	BOOST_CONCEPT_ASSERT((Permutation<Perm>));
+	assert(&set != &image);
+	image.resize(set.size());
+	image.reset();
+	for(auto i = set.find_first(); i != set.npos; i = set.find_next(i))
+		image.set(perm_group::get(p, i));
+}
+
+// rst: .. function:: template<typename PermPtrIter, typename ValueType> \
+// rst:               void apply_multi(PermPtrIter pFirst, PermPtrIter pLast, const ValueType *first, const ValueType *last, ValueType *out)
+// rst:
+// rst:		Requires the iterators to iterate over pointer-like values to permutations (`Permutation`)
+// rst:		with `value_type` `ValueType`.
+// rst:
+// rst:		Apply each of the `k` permutations pointed to in the range `pFirst` to `pLast` to all `m` elements
+// rst:		in the range `first` to `last`, storing the image of element `j` under permutation `i` in `out[i * m + j]`.
+// rst:		The input is processed in one pass, in tiles which stay in the L1 cache while all permutations are applied.
+// rst:		The output must not overlap the input.
+
+template<typename PermPtrIter, typename ValueType>
+void apply_multi(PermPtrIter pFirst, PermPtrIter pLast, const ValueType *first, const ValueType *last, ValueType *out) {
+	constexpr std::size_t tile = detail::materialize_tile_size<ValueType>();
+	const std::size_t m = last - first;
+	for(std::size_t tFirst = 0; tFirst < m; tFirst += tile) {
+		const std::size_t len = std::min(tile, m - tFirst);
+		std::size_t row = 0;
+		for(PermPtrIter pIter = pFirst; pIter != pLast; ++pIter, ++row)
+			perm_group::apply(**pIter, first + tFirst, first + tFirst + len, out + row * m + tFirst);
+	}
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_APPLY_HPP */
@@ -30,6 +30,19 @@ struct array_permutation {
 	void put_(value_type i, value_type image) {
 		p[i] = image;
 	}
+
+	// rst:		.. function:: value_type *data_()
+	// rst:		              const value_type *data_() const
+	// rst:
+	// rst:			:returns: a pointer to the underlying array of images, see `contiguous_images`.
+
+	value_type *data_() {
+		return p.get();
+	}
+
+	const value_type *data_() const {
+		return p.get();
+	}
 private:
 	std::unique_ptr<value_type[] > p;
 };
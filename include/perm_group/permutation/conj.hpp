@@ -0,0 +1,196 @@
+#ifndef PERM_GROUP_PERMUTATION_CONJ_HPP
+#define PERM_GROUP_PERMUTATION_CONJ_HPP
+
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/materialize.hpp>
+#include <perm_group/permutation/mult.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace perm_group {
+namespace detail {
+
+template<typename ValueType>
+using owned_inverse = std::shared_ptr<const std::vector<ValueType> >;
+
+template<typename ValueType, typename Perm>
+owned_inverse<ValueType> make_owned_inverse(const Perm &p, std::size_t n) {
+	auto inv = std::make_shared<std::vector<ValueType> >(n);
+	for(std::size_t i = 0; i != n; ++i)
+		(*inv)[perm_group::get(p, i)] = i;
+	return inv;
+}
+
+// Keeps computed inverses alive for the expressions referring to them.
+// It is a base class such that it is initialized before the expression.
+
+template<typename ValueType, std::size_t N>
+struct owned_inverses {
+	std::array<owned_inverse<ValueType>, N> inverses;
+};
+
+template<typename X>
+using expr_value_type = typename permutation_traits<typename std::remove_reference<X>::type>::value_type;
+
+} // namespace detail
+
+// rst: .. class:: template<typename PermP, typename PermG, typename PermGInv> \
+// rst:            conj_expr
+// rst:
+// rst:		An expression template for the conjugate :math:`g^{-1} p g` which acts as `Permutation`,
+// rst:		i.e., the image of `x` is `g(p(ginv(x)))`.
+// rst:		It is equivalent to `mult(mult(ginv, p), g)`, and is flattened into its three factors by `materialize`.
+// rst:		Use `conj` to create it.
+
+template<typename PermP, typename PermG, typename PermGInv>
+struct conj_expr
+: private detail::owned_inverses<detail::expr_value_type<PermP>, 1>,
+public mult_expr<mult_expr<PermGInv, PermP>, PermG> {
+	using base_expr = mult_expr<mult_expr<PermGInv, PermP>, PermG>;
+private:
+	using Storage = detail::owned_inverses<detail::expr_value_type<PermP>, 1>;
+public:
+
+	conj_expr(PermP p, PermG g, PermGInv gInv)
+	: base_expr(mult_expr<PermGInv, PermP>(gInv, p), g) { }
+
+	conj_expr(PermP p, PermG g, detail::owned_inverse<detail::expr_value_type<PermP> > gInv)
+	: Storage{{{gInv}}}, base_expr(mult_expr<PermGInv, PermP>(*gInv, p), g) { }
+};
+
+// rst: .. class:: template<typename PermA, typename PermB, typename PermAInv, typename PermBInv> \
+// rst:            commutator_expr
+// rst:
+// rst:		An expression template for the commutator :math:`a^{-1} b^{-1} a b` which acts as `Permutation`,
+// rst:		i.e., the image of `x` is `b(a(binv(ainv(x))))`.
+// rst:		It is flattened into its four factors by `materialize`.
+// rst:		Use `commutator` to create it.
+
+template<typename PermA, typename PermB, typename PermAInv, typename PermBInv>
+struct commutator_expr
+: private detail::owned_inverses<detail::expr_value_type<PermA>, 2>,
+public mult_expr<mult_expr<mult_expr<PermAInv, PermBInv>, PermA>, PermB> {
+	using base_expr = mult_expr<mult_expr<mult_expr<PermAInv, PermBInv>, PermA>, PermB>;
+private:
+	using Storage = detail::owned_inverses<detail::expr_value_type<PermA>, 2>;
+public:
+
+	commutator_expr(PermA a, PermB b, PermAInv aInv, PermBInv bInv)
+	: base_expr(make_inner(a, aInv, bInv), b) { }
+
+	commutator_expr(PermA a, PermB b,
+			detail::owned_inverse<detail::expr_value_type<PermA> > aInv,
+			detail::owned_inverse<detail::expr_value_type<PermA> > bInv)
+	: Storage{{{aInv, bInv}}}, base_expr(make_inner(a, *aInv, *bInv), b) { }
+private:
+
+	static mult_expr<mult_expr<PermAInv, PermBInv>, PermA> make_inner(PermA a, PermAInv aInv, PermBInv bInv) {
+		return mult_expr<mult_expr<PermAInv, PermBInv>, PermA>(mult_expr<PermAInv, PermBInv>(aInv, bInv), a);
+	}
+};
+
+// rst: .. function:: template<typename PermP, typename PermG, typename PermGInv> \
+// rst:               conj_expr<PermP, PermG, PermGInv> conj(PermP &&p, PermG &&g, PermGInv &&gInv)
+// rst:               template<typename PermP, typename PermG> \
+// rst:               auto conj(PermP &&p, PermG &&g)
+// rst:
+// rst:		:returns: an expression template for :math:`g^{-1} p g`, see `conj_expr`.
+// rst:
+// rst:		The first overload uses `gInv` as the inverse of `g`.
+// rst:		The second overload requires `DegreeAwarePermutation<PermG>`,
+// rst:		and computes the inverse of `g` once into an array shared by copies of the expression.
+// rst:		When conjugating many permutations with the same `g`, compute the inverse once and use the first overload,
+// rst:		e.g., as `make_conjugates` does.
+
+template<typename PermP, typename PermG, typename PermGInv>
+conj_expr<PermP, PermG, PermGInv> conj(PermP &&p, PermG &&g, PermGInv &&gInv) {
+	return conj_expr<PermP, PermG, PermGInv>(std::forward<PermP>(p), std::forward<PermG>(g), std::forward<PermGInv>(gInv));
+}
+
+template<typename PermP, typename PermG>
+auto conj(PermP &&p, PermG &&g) {
+	using value_type = detail::expr_value_type<PermP>;
+	using Inv = const std::vector<value_type>&;
+	auto gInv = detail::make_owned_inverse<value_type>(g, perm_group::degree(g));
+	return conj_expr<PermP, PermG, Inv>(std::forward<PermP>(p), std::forward<PermG>(g), gInv);
+}
+
+// rst: .. function:: template<typename PermA, typename PermB, typename PermAInv, typename PermBInv> \
+// rst:               commutator_expr<PermA, PermB, PermAInv, PermBInv> commutator(PermA &&a, PermB &&b, PermAInv &&aInv, PermBInv &&bInv)
+// rst:               template<typename PermA, typename PermB> \
+// rst:               auto commutator(PermA &&a, PermB &&b)
+// rst:
+// rst:		:returns: an expression template for :math:`a^{-1} b^{-1} a b`, see `commutator_expr`.
+// rst:
+// rst:		The first overload uses the given inverses.
+// rst:		The second overload requires `DegreeAwarePermutation<PermA>` and `DegreeAwarePermutation<PermB>`,
+// rst:		and computes the inverses as `conj` does.
+
+template<typename PermA, typename PermB, typename PermAInv, typename PermBInv>
+commutator_expr<PermA, PermB, PermAInv, PermBInv> commutator(PermA &&a, PermB &&b, PermAInv &&aInv, PermBInv &&bInv) {
+	return commutator_expr<PermA, PermB, PermAInv, PermBInv>(std::forward<PermA>(a), std::forward<PermB>(b),
+			std::forward<PermAInv>(aInv), std::forward<PermBInv>(bInv));
+}
+
+template<typename PermA, typename PermB>
+auto commutator(PermA &&a, PermB &&b) {
+	using value_type = detail::expr_value_type<PermA>;
+	using Inv = const std::vector<value_type>&;
+	auto aInv = detail::make_owned_inverse<value_type>(a, perm_group::degree(a));
+	auto bInv = detail::make_owned_inverse<value_type>(b, perm_group::degree(b));
+	return commutator_expr<PermA, PermB, Inv, Inv>(std::forward<PermA>(a), std::forward<PermB>(b), aInv, bInv);
+}
+
+// rst: .. function:: template<typename Alloc, typename GenPtrIter, typename Perm, typename OutputIterator> \
+// rst:               OutputIterator make_conjugates(Alloc &alloc, GenPtrIter first, GenPtrIter last, const Perm &g, OutputIterator out)
+// rst:
+// rst:		Requires `Allocator<Alloc>` and `DegreeAwarePermutation<Perm>`.
+// rst:
+// rst:		For each permutation pointed to in the range `first` to `last`, write a pointer to its conjugate by `g`
+// rst:		to `out`. The conjugates are created with `make_materialized`, and the inverse of `g` is computed only once.
+// rst:
+// rst:		:returns: the output iterator after the last written pointer.
+
+template<typename Alloc, typename GenPtrIter, typename Perm, typename OutputIterator>
+OutputIterator make_conjugates(Alloc &alloc, GenPtrIter first, GenPtrIter last, const Perm &g, OutputIterator out) {
+	using value_type = typename permutation_traits<Perm>::value_type;
+	std::vector<value_type> gInv(alloc.degree());
+	for(std::size_t i = 0; i != gInv.size(); ++i)
+		gInv[perm_group::get(g, i)] = i;
+	for(; first != last; ++first, ++out)
+		*out = perm_group::make_materialized(alloc, perm_group::conj(**first, g, gInv));
+	return out;
+}
+
+namespace detail {
+
+// Both expressions are evaluated as the mult_expr they derive from.
+
+template<typename PermP, typename PermG, typename PermGInv>
+struct materialize_node<conj_expr<PermP, PermG, PermGInv> >
+: materialize_node<typename conj_expr<PermP, PermG, PermGInv>::base_expr> {
+};
+
+template<typename PermA, typename PermB, typename PermAInv, typename PermBInv>
+struct materialize_node<commutator_expr<PermA, PermB, PermAInv, PermBInv> >
+: materialize_node<typename commutator_expr<PermA, PermB, PermAInv, PermBInv>::base_expr> {
+};
+
+template<typename PermP, typename PermG, typename PermGInv>
+struct support_traits<conj_expr<PermP, PermG, PermGInv> >
+: support_traits<typename conj_expr<PermP, PermG, PermGInv>::base_expr> {
+};
+
+template<typename PermA, typename PermB, typename PermAInv, typename PermBInv>
+struct support_traits<commutator_expr<PermA, PermB, PermAInv, PermBInv> >
+: support_traits<typename commutator_expr<PermA, PermB, PermAInv, PermBInv>::base_expr> {
+};
+
+} // namespace detail
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_CONJ_HPP */
@@ -0,0 +1,74 @@
+#ifndef PERM_GROUP_PERMUTATION_CONTIGUOUS_HPP
+#define PERM_GROUP_PERMUTATION_CONTIGUOUS_HPP
+
+#include <perm_group/permutation/traits.hpp>
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+namespace perm_group {
+
+// rst: Some permutations store the image of each element in a contiguous array,
+// rst: i.e., the image of `i` is at offset `i`.
+// rst: Bulk algorithms can exploit this, e.g., with vectorized gathers instead of
+// rst: calling `perm_group::get` for each element.
+// rst:
+// rst: .. function:: template<typename T, typename Allocator> \
+// rst:               T *contiguous_images(std::vector<T, Allocator> &p)
+// rst:               template<typename T, typename Allocator> \
+// rst:               const T *contiguous_images(const std::vector<T, Allocator> &p)
+// rst:               template<typename T, std::size_t N> \
+// rst:               T *contiguous_images(std::array<T, N> &p)
+// rst:               template<typename T, std::size_t N> \
+// rst:               const T *contiguous_images(const std::array<T, N> &p)
+// rst:               template<typename Perm> \
+// rst:               auto contiguous_images(Perm &p)
+// rst:
+// rst:		:returns: a pointer to the image array of `p`.
+// rst:		  The last overload participates only if `p.data_()` is a valid expression, and returns that.
+
+template<typename T, typename Allocator>
+T *contiguous_images(std::vector<T, Allocator> &p) {
+	return p.data();
+}
+
+template<typename T, typename Allocator>
+const T *contiguous_images(const std::vector<T, Allocator> &p) {
+	return p.data();
+}
+
+template<typename T, std::size_t N>
+T *contiguous_images(std::array<T, N> &p) {
+	return p.data();
+}
+
+template<typename T, std::size_t N>
+const T *contiguous_images(const std::array<T, N> &p) {
+	return p.data();
+}
+
+template<typename Perm>
+auto contiguous_images(Perm &p) -> decltype(p.data_()) {
+	return p.data_();
+}
+
+// rst: .. class:: template<typename Perm> \
+// rst:            has_contiguous_images
+// rst:
+// rst:		A type derived from `std::true_type` if `perm_group::contiguous_images(p)` is valid
+// rst:		for an lvalue `p` of type `Perm`, and otherwise derived from `std::false_type`.
+// rst:		`Perm` may be const-qualified.
+
+template<typename Perm, typename = void>
+struct has_contiguous_images : std::false_type {
+};
+
+template<typename Perm>
+struct has_contiguous_images<Perm, detail::void_t<decltype(perm_group::contiguous_images(std::declval<Perm&>()))> >
+: std::true_type {
+};
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_CONTIGUOUS_HPP */
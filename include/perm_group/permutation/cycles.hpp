@@ -0,0 +1,303 @@
+#ifndef PERM_GROUP_PERMUTATION_CYCLES_HPP
+#define PERM_GROUP_PERMUTATION_CYCLES_HPP
+
+#include <perm_group/permutation/permutation.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace perm_group {
+namespace detail {
+
+// k mod len in [0, len[, also for negative k
+
+template<typename Int>
+std::size_t power_offset(Int k, std::size_t len, std::true_type) {
+	if(k >= 0) return static_cast<std::uintmax_t>(k) % len;
+	// -(k + 1) can not overflow, unlike -k
+	return len - 1 - static_cast<std::uintmax_t>(-(k + 1)) % len;
+}
+
+template<typename Int>
+std::size_t power_offset(Int k, std::size_t len, std::false_type) {
+	return static_cast<std::uintmax_t>(k) % len;
+}
+
+inline std::uintmax_t gcd(std::uintmax_t a, std::uintmax_t b) {
+	while(b != 0) {
+		const auto r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+// the elements are written as std::size_t, so small value types are not written as characters
+
+template<typename Cycles>
+std::ostream &write_cycles(std::ostream &s, const Cycles &cd) {
+	if(cd.num_cycles() == 0) return s << "()";
+	for(std::size_t c = 0; c != cd.num_cycles(); ++c) {
+		s << '(' << static_cast<std::size_t> (*cd.cycle_begin(c));
+		for(auto iter = cd.cycle_begin(c) + 1; iter != cd.cycle_end(c); ++iter)
+			s << ' ' << static_cast<std::size_t> (*iter);
+		s << ')';
+	}
+	return s;
+}
+
+} // namespace detail
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            cycle_decomposition
+// rst:
+// rst:		The decomposition of a permutation of degree `n` into disjoint cycles.
+// rst:		Only the non-trivial cycles are stored, each starting with its smallest element,
+// rst:		and the cycles are ordered by their first element.
+// rst:		Computing the decomposition takes O(n) time, after which it can be used for computing
+// rst:		powers and the element order without further composition of permutations.
+// rst:
+
+template<typename ValueType>
+struct cycle_decomposition {
+	using value_type = ValueType;
+public:
+
+	// rst:		.. function:: cycle_decomposition()
+	// rst:
+	// rst:			Construct the decomposition of the identity of degree 0.
+
+	cycle_decomposition() : n(0), offsets(1, 0) { }
+
+	// rst:		.. function:: template<typename Perm> \
+	// rst:		              cycle_decomposition(const Perm &p, std::size_t n)
+	// rst:
+	// rst:			Construct the decomposition of `p` on the domain `[0, n[`.
+
+	template<typename Perm>
+	cycle_decomposition(const Perm &p, std::size_t n) : n(n), offsets(1, 0) {
+		BOOST_CONCEPT_ASSERT((Permutation<Perm>));
+		std::vector<bool> visited(n, false);
+		for(std::size_t i = 0; i != n; ++i) {
+			if(visited[i]) continue;
+			visited[i] = true;
+			const value_type start = i;
+			value_type next = perm_group::get(p, start);
+			if(next == start) continue;
+			points.push_back(start);
+			for(; next != start; next = perm_group::get(p, next)) {
+				assert(!visited[next]);
+				visited[next] = true;
+				points.push_back(next);
+			}
+			offsets.push_back(points.size());
+		}
+	}
+
+	// rst:		.. function:: std::size_t degree() const
+	// rst:
+	// rst:			:returns: the degree of the decomposed permutation.
+
+	std::size_t degree() const {
+		return n;
+	}
+
+	// rst:		.. function:: std::size_t num_cycles() const
+	// rst:
+	// rst:			:returns: the number of non-trivial cycles.
+
+	std::size_t num_cycles() const {
+		return offsets.size() - 1;
+	}
+
+	// rst:		.. function:: std::size_t support_size() const
+	// rst:
+	// rst:			:returns: the number of moved elements.
+
+	std::size_t support_size() const {
+		return points.size();
+	}
+
+	// rst:		.. function:: const value_type *cycle_begin(std::size_t c) const
+	// rst:		              const value_type *cycle_end(std::size_t c) const
+	// rst:
+	// rst:			:returns: the range of elements in cycle `c`, such that each element is mapped to the next,
+	// rst:			  and the last element to the first.
+
+	const value_type *cycle_begin(std::size_t c) const {
+		return points.data() + offsets[c];
+	}
+
+	const value_type *cycle_end(std::size_t c) const {
+		return points.data() + offsets[c + 1];
+	}
+
+	// rst:		.. function:: std::size_t cycle_length(std::size_t c) const
+	// rst:
+	// rst:			:returns: the number of elements in cycle `c`.
+
+	std::size_t cycle_length(std::size_t c) const {
+		return offsets[c + 1] - offsets[c];
+	}
+
+	// rst:		.. function:: std::vector<std::size_t> cycle_type() const
+	// rst:
+	// rst:			:returns: the lengths of the non-trivial cycles in non-increasing order.
+	// rst:			  The number of fixed points is `degree() - support_size()`.
+
+	std::vector<std::size_t> cycle_type() const {
+		std::vector<std::size_t> res(num_cycles());
+		for(std::size_t c = 0; c != res.size(); ++c)
+			res[c] = cycle_length(c);
+		std::sort(res.begin(), res.end(), std::greater<std::size_t>());
+		return res;
+	}
+
+	// rst:		.. function:: std::uintmax_t order() const
+	// rst:
+	// rst:			:returns: the order of the permutation, i.e., the least common multiple of the cycle lengths.
+	// rst:			:throws: `std::overflow_error` if the order can not be represented.
+
+	std::uintmax_t order() const {
+		std::uintmax_t res = 1;
+		for(std::size_t c = 0; c != num_cycles(); ++c) {
+			const std::uintmax_t len = cycle_length(c);
+			const auto factor = len / detail::gcd(res, len);
+			if(res > std::numeric_limits<std::uintmax_t>::max() / factor)
+				throw std::overflow_error("Permutation order too large.");
+			res *= factor;
+		}
+		return res;
+	}
+
+	// rst:		.. function:: template<typename Int, typename Perm> \
+	// rst:		              void power(Int k, Perm &dst) const
+	// rst:
+	// rst:			Requires `MutablePermutation<Perm>`.
+	// rst:
+	// rst:			Store the `k` th power of the permutation in `dst`, which may be negative if `Int` is signed.
+	// rst:			It takes O(n) time regardless of `k`.
+
+	template<typename Int, typename Perm>
+	void power(Int k, Perm &dst) const {
+		BOOST_CONCEPT_ASSERT((MutablePermutation<Perm>));
+		static_assert(std::is_integral<Int>::value, "The exponent must be an integer.");
+		for(std::size_t i = 0; i != n; ++i)
+			perm_group::put(dst, i, i);
+		for(std::size_t c = 0; c != num_cycles(); ++c) {
+			const auto first = cycle_begin(c);
+			const std::size_t len = cycle_length(c);
+			const std::size_t offset = detail::power_offset(k, len, std::is_signed<Int>());
+			for(std::size_t i = 0, j = offset; i != len; ++i) {
+				perm_group::put(dst, first[i], first[j]);
+				if(++j == len) j = 0;
+			}
+		}
+	}
+
+	// rst:		.. function:: friend std::ostream &operator<<(std::ostream &s, const cycle_decomposition &cd)
+	// rst:
+	// rst:			Write the decomposition in cycle notation, in the format of `write_permutation_cycles`.
+
+	friend std::ostream &operator<<(std::ostream &s, const cycle_decomposition &cd) {
+		return detail::write_cycles(s, cd);
+	}
+private:
+	std::size_t n;
+	std::vector<value_type> points;
+	std::vector<std::size_t> offsets;
+};
+
+// rst: .. function:: template<typename Perm> \
+// rst:               cycle_decomposition<typename permutation_traits<Perm>::value_type> make_cycle_decomposition(const Perm &p, std::size_t n)
+// rst:               template<typename Perm> \
+// rst:               cycle_decomposition<typename permutation_traits<Perm>::value_type> make_cycle_decomposition(const Perm &p)
+// rst:
+// rst:		The second overload requires `DegreeAwarePermutation<Perm>` and uses `n = perm_group::degree(p)`.
+// rst:
+// rst:		:returns: the cycle decomposition of `p`.
+
+template<typename Perm>
+cycle_decomposition<typename permutation_traits<Perm>::value_type> make_cycle_decomposition(const Perm &p, std::size_t n) {
+	return cycle_decomposition<typename permutation_traits<Perm>::value_type>(p, n);
+}
+
+template<typename Perm>
+cycle_decomposition<typename permutation_traits<Perm>::value_type> make_cycle_decomposition(const Perm &p) {
+	BOOST_CONCEPT_ASSERT((DegreeAwarePermutation<Perm>));
+	return make_cycle_decomposition(p, perm_group::degree(p));
+}
+
+// rst: .. function:: template<typename Perm, typename Int> \
+// rst:               Perm power(const Perm &p, Int k, std::size_t n)
+// rst:               template<typename Perm, typename Int> \
+// rst:               Perm power(const Perm &p, Int k)
+// rst:
+// rst:		The second overload requires `DegreeAwarePermutation<Perm>` and uses `n = perm_group::degree(p)`.
+// rst:
+// rst:		:returns: the `k` th power of `p`, created with `make_perm`.
+// rst:		  It takes O(n) time regardless of `k`, see `cycle_decomposition::power`.
+
+template<typename Perm, typename Int>
+Perm power(const Perm &p, Int k, std::size_t n) {
+	Perm res = perm_group::make_perm<Perm>(n);
+	perm_group::make_cycle_decomposition(p, n).power(k, res);
+	return res;
+}
+
+template<typename Perm, typename Int>
+Perm power(const Perm &p, Int k) {
+	BOOST_CONCEPT_ASSERT((DegreeAwarePermutation<Perm>));
+	return perm_group::power(p, k, perm_group::degree(p));
+}
+
+// rst: .. function:: template<typename Perm> \
+// rst:               std::uintmax_t order(const Perm &p, std::size_t n)
+// rst:               template<typename Perm> \
+// rst:               std::uintmax_t order(const Perm &p)
+// rst:
+// rst:		The second overload requires `DegreeAwarePermutation<Perm>` and uses `n = perm_group::degree(p)`.
+// rst:
+// rst:		:returns: the order of `p`, see `cycle_decomposition::order`.
+
+template<typename Perm>
+std::uintmax_t order(const Perm &p, std::size_t n) {
+	return perm_group::make_cycle_decomposition(p, n).order();
+}
+
+template<typename Perm>
+std::uintmax_t order(const Perm &p) {
+	BOOST_CONCEPT_ASSERT((DegreeAwarePermutation<Perm>));
+	return perm_group::order(p, perm_group::degree(p));
+}
+
+// rst: .. function:: template<typename Perm> \
+// rst:               std::vector<std::size_t> cycle_type(const Perm &p, std::size_t n)
+// rst:               template<typename Perm> \
+// rst:               std::vector<std::size_t> cycle_type(const Perm &p)
+// rst:
+// rst:		The second overload requires `DegreeAwarePermutation<Perm>` and uses `n = perm_group::degree(p)`.
+// rst:
+// rst:		:returns: the cycle type of `p`, see `cycle_decomposition::cycle_type`.
+
+template<typename Perm>
+std::vector<std::size_t> cycle_type(const Perm &p, std::size_t n) {
+	return perm_group::make_cycle_decomposition(p, n).cycle_type();
+}
+
+template<typename Perm>
+std::vector<std::size_t> cycle_type(const Perm &p) {
+	BOOST_CONCEPT_ASSERT((DegreeAwarePermutation<Perm>));
+	return perm_group::cycle_type(p, perm_group::degree(p));
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_CYCLES_HPP */
@@ -3,6 +3,7 @@
 
 #include <perm_group/config.hpp>
 #include <perm_group/io.hpp>
+#include <perm_group/permutation/cycles.hpp>
 #include <perm_group/permutation/permutation.hpp>
 
 #include <cassert>
@@ -99,29 +100,12 @@ void read_permutation_cycles(const std::string &s, Perm &p) {
 // rst: .. function:: template<typename Perm> \
 // rst:	              std::ostream &write_permutation_cycles(std::ostream &s, const Perm &p, std::size_t n)
 // rst:
-// rst:		Write a permutation in cycle notation.
+// rst:		Write a permutation in cycle notation, through its `cycle_decomposition`.
 
 template<typename Perm>
 std::ostream &write_permutation_cycles(std::ostream &s, const Perm &p, std::size_t n) {
 	BOOST_CONCEPT_ASSERT((Permutation<Perm>));
-	std::vector<bool> printed(n, false);
-	bool anyPrinted = false;
-	for(std::size_t i = 0; i < n; ++i) {
-		if(printed[i]) continue;
-		if(perm_group::get(p, i) == i) continue;
-		anyPrinted = true;
-		std::size_t start = i;
-		s << '(' << i;
-		printed[i] = true;
-		for(std::size_t next = perm_group::get(p, i); next != start; next = perm_group::get(p, next)) {
-			assert(!printed[next]);
-			printed[next] = true;
-			s << ' ' << next;
-		}
-		s << ')';
-	}
-	if(!anyPrinted) s << "()";
-	return s;
+	return detail::write_cycles(s, perm_group::make_cycle_decomposition(p, n));
 }
 
 // rst: .. function:: template<typename Perm> \
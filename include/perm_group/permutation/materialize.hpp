@@ -0,0 +1,271 @@
+#ifndef PERM_GROUP_PERMUTATION_MATERIALIZE_HPP
+#define PERM_GROUP_PERMUTATION_MATERIALIZE_HPP
+
+#include <perm_group/permutation/contiguous.hpp>
+#include <perm_group/permutation/mult.hpp>
+#include <perm_group/permutation/permutation.hpp>
+#include <perm_group/permutation/word.hpp>
+#include <perm_group/util/simd.hpp>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace perm_group {
+namespace detail {
+
+// The domain is evaluated in tiles of this many bytes,
+// such that the scratch buffer stays in L1 while every factor is applied to it.
+constexpr std::size_t materialize_tile_bytes = 8 * 1024;
+// Below this degree the whole expression is evaluated point by point.
+constexpr std::size_t materialize_pointwise_max_degree = 64;
+// When all factors together take up at most this many bytes they are cache resident,
+// and chasing each point through them is cheaper than composing tile by tile.
+constexpr std::size_t materialize_pointwise_max_bytes = 32 * 1024;
+
+template<typename ValueType>
+constexpr std::size_t materialize_tile_size() {
+	return materialize_tile_bytes / sizeof(ValueType);
+}
+
+template<typename Perm, typename ValueType>
+using is_contiguous_as = std::integral_constant<bool,
+		has_contiguous_images<const Perm>::value
+		&& std::is_same<typename permutation_traits<Perm>::value_type, ValueType>::value>;
+
+template<typename Perm>
+struct materialize_node;
+
+template<typename X>
+using materialize_node_of = materialize_node<typename std::decay<X>::type>;
+
+// A leaf, i.e., an ordinary permutation.
+
+template<typename Perm>
+struct materialize_node {
+
+	static std::size_t num_factors(const Perm &p) {
+		return 1;
+	}
+
+	// buf[j] = p(first + j) for j in [0, len[
+
+	template<typename ValueType>
+	static void init(const Perm &p, ValueType *buf, std::size_t first, std::size_t len) {
+		init(p, buf, first, len, is_contiguous_as<Perm, ValueType>());
+	}
+
+	// buf[j] = p(buf[j]) for j in [0, len[
+
+	template<typename ValueType>
+	static void apply(const Perm &p, ValueType *buf, std::size_t len) {
+		apply(p, buf, len, is_contiguous_as<Perm, ValueType>());
+	}
+private:
+
+	template<typename ValueType>
+	static void init(const Perm &p, ValueType *buf, std::size_t first, std::size_t len, std::true_type) {
+		const auto *images = perm_group::contiguous_images(p);
+		std::copy(images + first, images + first + len, buf);
+	}
+
+	template<typename ValueType>
+	static void init(const Perm &p, ValueType *buf, std::size_t first, std::size_t len, std::false_type) {
+		for(std::size_t j = 0; j != len; ++j)
+			buf[j] = perm_group::get(p, first + j);
+	}
+
+	template<typename ValueType>
+	static void apply(const Perm &p, ValueType *buf, std::size_t len, std::true_type) {
+		detail::gather_inplace(perm_group::contiguous_images(p), buf, len);
+	}
+
+	template<typename ValueType>
+	static void apply(const Perm &p, ValueType *buf, std::size_t len, std::false_type) {
+		for(std::size_t j = 0; j != len; ++j)
+			buf[j] = perm_group::get(p, buf[j]);
+	}
+};
+
+template<typename PermL, typename PermR>
+struct materialize_node<mult_expr<PermL, PermR> > {
+	using Expr = mult_expr<PermL, PermR>;
+
+	static std::size_t num_factors(const Expr &e) {
+		return materialize_node_of<PermL>::num_factors(e.get_left())
+				+ materialize_node_of<PermR>::num_factors(e.get_right());
+	}
+
+	template<typename ValueType>
+	static void init(const Expr &e, ValueType *buf, std::size_t first, std::size_t len) {
+		materialize_node_of<PermL>::init(e.get_left(), buf, first, len);
+		materialize_node_of<PermR>::apply(e.get_right(), buf, len);
+	}
+
+	template<typename ValueType>
+	static void apply(const Expr &e, ValueType *buf, std::size_t len) {
+		materialize_node_of<PermL>::apply(e.get_left(), buf, len);
+		materialize_node_of<PermR>::apply(e.get_right(), buf, len);
+	}
+};
+
+template<typename Word>
+struct materialize_node_word {
+	using perm = typename std::remove_cv<typename Word::perm>::type;
+	using Leaf = materialize_node<perm>;
+
+	static std::size_t num_factors(const Word &w) {
+		return w.size();
+	}
+
+	template<typename ValueType>
+	static void init(const Word &w, ValueType *buf, std::size_t first, std::size_t len) {
+		if(w.empty()) {
+			for(std::size_t j = 0; j != len; ++j)
+				buf[j] = first + j;
+			return;
+		}
+		Leaf::init(*w[0], buf, first, len);
+		apply(w, 1, buf, len, is_contiguous_as<perm, ValueType>());
+	}
+
+	template<typename ValueType>
+	static void apply(const Word &w, ValueType *buf, std::size_t len) {
+		apply(w, 0, buf, len, is_contiguous_as<perm, ValueType>());
+	}
+private:
+
+	template<typename ValueType>
+	static void apply(const Word &w, std::size_t k, ValueType *buf, std::size_t len, std::true_type) {
+		// while applying factor k, prefetch the entries of factor k + 1 which are needed next
+		if(k == w.size()) return;
+		for(; k + 1 != w.size(); ++k)
+			detail::gather_inplace_prefetch(perm_group::contiguous_images(*w[k]), buf, len,
+				perm_group::contiguous_images(*w[k + 1]));
+		detail::gather_inplace(perm_group::contiguous_images(*w[k]), buf, len);
+	}
+
+	template<typename ValueType>
+	static void apply(const Word &w, std::size_t k, ValueType *buf, std::size_t len, std::false_type) {
+		for(; k != w.size(); ++k)
+			Leaf::apply(*w[k], buf, len);
+	}
+};
+
+template<typename Pointer>
+struct materialize_node<permutation_word<Pointer> > : materialize_node_word<permutation_word<Pointer> > {
+};
+
+template<typename Pointer>
+struct materialize_node<permutation_word_fixed<Pointer> > : materialize_node_word<permutation_word_fixed<Pointer> > {
+};
+
+template<typename Expr, typename Perm>
+void materialize_pointwise(const Expr &e, Perm &dst, std::size_t n) {
+	for(std::size_t i = 0; i != n; ++i)
+		perm_group::put(dst, i, perm_group::get(e, i));
+}
+
+template<typename Expr, typename Perm>
+void materialize_tiled(const Expr &e, Perm &dst, std::size_t n, std::true_type) {
+	using value_type = typename permutation_traits<Expr>::value_type;
+	constexpr std::size_t tile = materialize_tile_size<value_type>();
+	// evaluate directly into the destination
+	auto *images = perm_group::contiguous_images(dst);
+	for(std::size_t first = 0; first < n; first += tile) {
+		const std::size_t len = std::min(tile, n - first);
+		materialize_node_of<Expr>::init(e, images + first, first, len);
+	}
+}
+
+template<typename Expr, typename Perm>
+void materialize_tiled(const Expr &e, Perm &dst, std::size_t n, std::false_type) {
+	using value_type = typename permutation_traits<Expr>::value_type;
+	constexpr std::size_t tile = materialize_tile_size<value_type>();
+	std::vector<value_type> buf(std::min(tile, n));
+	for(std::size_t first = 0; first < n; first += tile) {
+		const std::size_t len = std::min(tile, n - first);
+		materialize_node_of<Expr>::init(e, buf.data(), first, len);
+		for(std::size_t j = 0; j != len; ++j)
+			perm_group::put(dst, first + j, buf[j]);
+	}
+}
+
+// The strategy used by materialize, selected by the type of the destination.
+// Destination types with a better strategy can specialize this.
+
+template<typename Perm>
+struct materialize_dispatch {
+
+	template<typename Expr>
+	static void materialize(const Expr &e, Perm &dst, std::size_t n) {
+		using expr_value_type = typename permutation_traits<Expr>::value_type;
+		const std::size_t factors = materialize_node_of<Expr>::num_factors(e);
+		if(n <= materialize_pointwise_max_degree
+				|| factors * n * sizeof(expr_value_type) <= materialize_pointwise_max_bytes) {
+			materialize_pointwise(e, dst, n);
+		} else {
+			materialize_tiled(e, dst, n, is_contiguous_as<Perm, expr_value_type>());
+		}
+	}
+};
+
+} // namespace detail
+
+// rst: .. function:: template<typename Expr, typename Perm> \
+// rst:               void materialize(const Expr &e, Perm &dst, std::size_t n)
+// rst:
+// rst:		Requires `Permutation<Expr>` and `MutablePermutation<Perm>`.
+// rst:
+// rst:		Store the first `n` images of `e` in `dst`.
+// rst:		Nested `mult_expr` objects, `permutation_word` and `permutation_word_fixed` are flattened into
+// rst:		their sequence of factors, and the domain is then processed in tiles:
+// rst:		each tile is initialized from the first factor and each following factor is applied to the whole tile,
+// rst:		instead of chasing each element through all factors.
+// rst:		Factors and destinations with `contiguous_images` are accessed directly, using vectorized gathers when available.
+// rst:		Within a word, the entries of the next factor which the tile will be looked up in are prefetched
+// rst:		while the current factor is applied.
+// rst:
+// rst:		When `n` is small, or when all `L` factors together, i.e., roughly `L * n` elements, fit in the L1 cache,
+// rst:		the expression is instead evaluated point by point, chasing each element through all factors.
+// rst:
+// rst:		Some destination types use their own strategy, e.g., `sparse_permutation`.
+// rst:		The destination must not be one of the factors of `e`.
+
+template<typename Expr, typename Perm>
+void materialize(const Expr &e, Perm &dst, std::size_t n) {
+	BOOST_CONCEPT_ASSERT((Permutation<Expr>));
+	BOOST_CONCEPT_ASSERT((MutablePermutation<Perm>));
+	detail::materialize_dispatch<Perm>::materialize(e, dst, n);
+}
+
+// rst: .. function:: template<typename Expr, typename Perm> \
+// rst:               void materialize(const Expr &e, Perm &dst)
+// rst:
+// rst:		Requires `DegreeAwarePermutation<Perm>`.
+// rst:
+// rst:		:returns: `materialize(e, dst, perm_group::degree(dst))`
+
+template<typename Expr, typename Perm>
+void materialize(const Expr &e, Perm &dst) {
+	BOOST_CONCEPT_ASSERT((DegreeAwarePermutation<Perm>));
+	perm_group::materialize(e, dst, perm_group::degree(dst));
+}
+
+// rst: .. function:: template<typename Alloc, typename Expr> \
+// rst:               typename Alloc::pointer make_materialized(Alloc &alloc, const Expr &e)
+// rst:
+// rst:		Requires `Allocator<Alloc>`.
+// rst:
+// rst:		:returns: a new permutation from `alloc.make()` which `e` has been materialized into.
+
+template<typename Alloc, typename Expr>
+typename Alloc::pointer make_materialized(Alloc &alloc, const Expr &e) {
+	typename Alloc::pointer p = alloc.make();
+	perm_group::materialize(e, *p, alloc.degree());
+	return p;
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_MATERIALIZE_HPP */
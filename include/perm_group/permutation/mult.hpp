@@ -32,6 +32,15 @@ public:
 	operator Perm() const {
 		return copy_perm<Perm>(*this);
 	}
+public:
+
+	const PermL_ &get_left() const {
+		return left;
+	}
+
+	const PermR_ &get_right() const {
+		return right;
+	}
 protected:
 	PermL left;
 	PermR right;
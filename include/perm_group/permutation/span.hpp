@@ -0,0 +1,63 @@
+#ifndef PERM_GROUP_PERMUTATION_SPAN_HPP
+#define PERM_GROUP_PERMUTATION_SPAN_HPP
+
+#include <cstddef>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            span_permutation
+// rst:
+// rst:		Models `Permutation` and `DegreeAwarePermutation` (but not `MutablePermutation`).
+// rst:
+// rst:		A non-owning read-only view of an existing array of images, i.e., the image of `i` is at offset `i`.
+// rst:		It allows permutations stored in user buffers to be passed to the library without copying them,
+// rst:		e.g., as queries to `generating_system::is_member`, as generators to `orbit`,
+// rst:		or to `generated_group::add_generator` which copies it only once into the allocator.
+// rst:		The buffer must outlive the view.
+// rst:
+
+template<typename ValueType>
+struct span_permutation {
+	using value_type = ValueType;
+public:
+
+	// rst:		.. function:: span_permutation(const value_type *images, std::size_t n)
+	// rst:
+	// rst:			Construct a view of the permutation of degree `n` with the given images.
+
+	span_permutation(const value_type *images, std::size_t n) : images(images), n(n) { }
+
+	value_type get_(value_type i) const {
+		return images[i];
+	}
+
+	std::size_t degree_() const {
+		return n;
+	}
+
+	// rst:		.. function:: const value_type *data_() const
+	// rst:
+	// rst:			:returns: the viewed array of images, see `contiguous_images`.
+
+	const value_type *data_() const {
+		return images;
+	}
+private:
+	const value_type *images;
+	std::size_t n;
+};
+
+// rst: .. function:: template<typename ValueType> \
+// rst:               span_permutation<ValueType> make_span_permutation(const ValueType *images, std::size_t n)
+// rst:
+// rst:		:returns: `span_permutation<ValueType>(images, n)`
+
+template<typename ValueType>
+span_permutation<ValueType> make_span_permutation(const ValueType *images, std::size_t n) {
+	return span_permutation<ValueType>(images, n);
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_SPAN_HPP */
@@ -0,0 +1,196 @@
+#ifndef PERM_GROUP_PERMUTATION_SPARSE_HPP
+#define PERM_GROUP_PERMUTATION_SPARSE_HPP
+
+#include <perm_group/permutation/materialize.hpp>
+#include <perm_group/permutation/support.hpp>
+#include <perm_group/permutation/traits.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+namespace perm_group {
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            sparse_permutation
+// rst:
+// rst:		Models `MutablePermutation` and `DegreeAwarePermutation`, and is support aware.
+// rst:
+// rst:		A permutation storing only the elements it moves, as a sorted array of the support
+// rst:		and a parallel array of their images.
+// rst:		It is meant for permutations on huge domains where each permutation only moves few elements.
+// rst:		Let `s` be the size of the support. Then `get` takes O(log s) time,
+// rst:		equality takes O(s) time, and inversion and materialization of compositions (see `materialize`)
+// rst:		take O(s log s) time.
+// rst:		A `put` which changes the support takes O(s) time, unless the support is extended at the end.
+// rst:
+
+template<typename ValueType>
+struct sparse_permutation {
+	using value_type = ValueType;
+
+	// rst:		.. function:: explicit sparse_permutation(std::size_t n)
+	// rst:
+	// rst:			Construct the identity permutation of degree `n`.
+
+	explicit sparse_permutation(std::size_t n) : n(n) { }
+
+	value_type get_(value_type i) const {
+		const auto iter = std::lower_bound(points.begin(), points.end(), i);
+		if(iter == points.end() || *iter != i) return i;
+		return images[iter - points.begin()];
+	}
+
+	void put_(value_type i, value_type image) {
+		assert(i < n);
+		assert(image < n);
+		if(points.empty() || points.back() < i) { // fast path for construction in increasing order
+			if(image == i) return;
+			points.push_back(i);
+			images.push_back(image);
+			return;
+		}
+		const auto iter = std::lower_bound(points.begin(), points.end(), i);
+		const auto pos = iter - points.begin();
+		if(iter != points.end() && *iter == i) {
+			if(image == i) {
+				points.erase(iter);
+				images.erase(images.begin() + pos);
+			} else {
+				images[pos] = image;
+			}
+		} else if(image != i) {
+			points.insert(iter, i);
+			images.insert(images.begin() + pos, image);
+		}
+	}
+
+	std::size_t degree_() const {
+		return n;
+	}
+
+	// rst:		.. function:: const std::vector<value_type> &support_() const
+	// rst:
+	// rst:			:returns: the sorted list of elements moved by the permutation.
+
+	const std::vector<value_type> &support_() const {
+		return points;
+	}
+
+	// rst:		.. function:: const std::vector<value_type> &support_images() const
+	// rst:
+	// rst:			:returns: the images of the elements returned by `support_`, in the same order.
+
+	const std::vector<value_type> &support_images() const {
+		return images;
+	}
+
+	// rst:		.. function:: void clear()
+	// rst:
+	// rst:			Reset to the identity permutation.
+
+	void clear() {
+		points.clear();
+		images.clear();
+	}
+
+	// rst:		.. function:: sparse_permutation inverse() const
+	// rst:
+	// rst:			:returns: the inverse permutation.
+
+	sparse_permutation inverse() const {
+		sparse_permutation res(n);
+		std::vector<std::size_t> order(points.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+			return images[a] < images[b];
+		});
+		res.points.reserve(points.size());
+		res.images.reserve(points.size());
+		for(const auto k : order) {
+			res.points.push_back(images[k]);
+			res.images.push_back(points[k]);
+		}
+		return res;
+	}
+
+	friend bool operator==(const sparse_permutation &a, const sparse_permutation &b) {
+		return a.n == b.n && a.points == b.points && a.images == b.images;
+	}
+
+	friend bool operator!=(const sparse_permutation &a, const sparse_permutation &b) {
+		return !(a == b);
+	}
+private:
+	std::size_t n;
+	std::vector<value_type> points, images;
+};
+
+// rst: .. class:: template<typename ValueType> \
+// rst:            permutation_traits<sparse_permutation<ValueType> >
+// rst:
+// rst:		As the default traits, but `make_identity` and `make_inverse` run in time independent of the degree.
+
+template<typename ValueType>
+struct permutation_traits<sparse_permutation<ValueType> > : detail::permutation_traits<sparse_permutation<ValueType> > {
+	using Perm = sparse_permutation<ValueType>;
+
+	static Perm make_identity(std::size_t n) {
+		return Perm(n);
+	}
+
+	static Perm make_inverse(const Perm &p, std::size_t n) {
+		return p.inverse();
+	}
+};
+
+namespace detail {
+
+// Only evaluate the expression on its support, if it has one.
+
+template<typename ValueType>
+struct materialize_dispatch<sparse_permutation<ValueType> > {
+	using Perm = sparse_permutation<ValueType>;
+
+	template<typename Expr>
+	static void materialize(const Expr &e, Perm &dst, std::size_t n) {
+		dst.clear();
+		materialize(e, dst, n, has_support<Expr>());
+	}
+private:
+
+	template<typename Expr>
+	static void materialize(const Expr &e, Perm &dst, std::size_t n, std::true_type) {
+		// the supports of the factors are sorted, so merge them instead of sorting their concatenation
+		std::vector<ValueType> support;
+		std::vector<std::size_t> runs(1, 0);
+		perm_group::for_each_support_point(e, [&support, &runs](const auto &x) {
+			if(!support.empty() && x < support.back()) runs.push_back(support.size());
+			support.push_back(x);
+			return true;
+		});
+		runs.push_back(support.size());
+		for(std::size_t width = 1; width + 1 < runs.size(); width *= 2) {
+			for(std::size_t i = 0; i + width + 1 < runs.size(); i += 2 * width) {
+				const std::size_t last = std::min(i + 2 * width, runs.size() - 1);
+				std::inplace_merge(support.begin() + runs[i], support.begin() + runs[i + width], support.begin() + runs[last]);
+			}
+		}
+		support.erase(std::unique(support.begin(), support.end()), support.end());
+		// the support is visited in increasing order, so each put appends, and each get is a binary search
+		for(const auto x : support)
+			perm_group::put(dst, x, perm_group::get(e, x));
+	}
+
+	template<typename Expr>
+	static void materialize(const Expr &e, Perm &dst, std::size_t n, std::false_type) {
+		for(std::size_t i = 0; i != n; ++i)
+			perm_group::put(dst, i, perm_group::get(e, i));
+	}
+};
+
+} // namespace detail
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_SPARSE_HPP */
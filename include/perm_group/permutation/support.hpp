@@ -0,0 +1,171 @@
+#ifndef PERM_GROUP_PERMUTATION_SUPPORT_HPP
+#define PERM_GROUP_PERMUTATION_SUPPORT_HPP
+
+#include <perm_group/permutation/mult.hpp>
+#include <perm_group/permutation/permutation.hpp>
+#include <perm_group/permutation/word.hpp>
+
+#include <type_traits>
+
+namespace perm_group {
+
+// rst: The support of a permutation is the set of elements it moves.
+// rst: Permutations which can enumerate (a superset of) their support without scanning the whole domain
+// rst: are called support aware, and algorithms can use this to run in time proportional to the support
+// rst: instead of the degree.
+// rst: A permutation type `Perm` is support aware if `p.support_()` is a valid expression for `const Perm p`,
+// rst: returning a range of `value_type` containing at least the elements moved by `p`.
+// rst: The `mult_expr` and `permutation_word` expressions are support aware when all their factors are,
+// rst: in which case the union of the factor supports is used.
+
+namespace detail {
+
+template<typename Perm, typename = void>
+struct support_traits {
+	using is_aware = std::false_type;
+};
+
+template<typename Perm>
+struct support_traits<Perm, void_t<decltype(std::declval<const Perm&>().support_())> > {
+	using is_aware = std::true_type;
+
+	template<typename F>
+	static bool for_each(const Perm &p, F &f) {
+		for(const auto &x : p.support_())
+			if(!f(x)) return false;
+		return true;
+	}
+};
+
+template<typename X>
+using support_traits_of = support_traits<typename std::decay<X>::type>;
+
+template<typename PermL, typename PermR>
+struct support_traits<mult_expr<PermL, PermR> > {
+	using is_aware = std::integral_constant<bool,
+			support_traits_of<PermL>::is_aware::value && support_traits_of<PermR>::is_aware::value>;
+
+	template<typename F>
+	static bool for_each(const mult_expr<PermL, PermR> &e, F &f) {
+		return support_traits_of<PermL>::for_each(e.get_left(), f)
+				&& support_traits_of<PermR>::for_each(e.get_right(), f);
+	}
+};
+
+template<typename Word>
+struct support_traits_word {
+	using Leaf = support_traits_of<typename Word::perm>;
+	using is_aware = typename Leaf::is_aware;
+
+	template<typename F>
+	static bool for_each(const Word &w, F &f) {
+		for(std::size_t k = 0; k != w.size(); ++k)
+			if(!Leaf::for_each(*w[k], f)) return false;
+		return true;
+	}
+};
+
+template<typename Pointer>
+struct support_traits<permutation_word<Pointer> > : support_traits_word<permutation_word<Pointer> > {
+};
+
+template<typename Pointer>
+struct support_traits<permutation_word_fixed<Pointer> > : support_traits_word<permutation_word_fixed<Pointer> > {
+};
+
+template<typename Perm>
+bool is_identity(const Perm &p, std::size_t n, std::true_type) {
+	auto isFixed = [&p](const auto &x) {
+		return perm_group::get(p, x) == x;
+	};
+	return support_traits_of<Perm>::for_each(p, isFixed);
+}
+
+template<typename Perm>
+bool is_identity(const Perm &p, std::size_t n, std::false_type) {
+	using value_type = typename permutation_traits<Perm>::value_type;
+	for(value_type i = 0; i != n; ++i) {
+		if(perm_group::get(p, i) != i)
+			return false;
+	}
+	return true;
+}
+
+template<typename Perm>
+std::size_t first_moved(const Perm &p, std::size_t n, std::true_type) {
+	std::size_t res = n;
+	auto update = [&p, &res](const auto &x) {
+		if(x < res && perm_group::get(p, x) != x)
+			res = x;
+		return true;
+	};
+	support_traits_of<Perm>::for_each(p, update);
+	return res;
+}
+
+template<typename Perm>
+std::size_t first_moved(const Perm &p, std::size_t n, std::false_type) {
+	using value_type = typename permutation_traits<Perm>::value_type;
+	for(value_type i = 0; i != n; ++i) {
+		if(perm_group::get(p, i) != i)
+			return i;
+	}
+	return n;
+}
+
+} // namespace detail
+
+// rst: .. class:: template<typename Perm> \
+// rst:            has_support
+// rst:
+// rst:		A type derived from `std::true_type` if `Perm` (after decaying) is support aware,
+// rst:		and otherwise derived from `std::false_type`.
+
+template<typename Perm>
+struct has_support : detail::support_traits_of<Perm>::is_aware {
+};
+
+// rst: .. function:: template<typename Perm, typename F> \
+// rst:               bool for_each_support_point(const Perm &p, F f)
+// rst:
+// rst:		Requires `has_support<Perm>`.
+// rst:
+// rst:		Call `f(x)` for each element `x` of the support superset of `p`, which may contain duplicates
+// rst:		when `p` is an expression.
+// rst:		The iteration stops early if `f` returns `false`.
+// rst:
+// rst:		:returns: `false` if the iteration was stopped early, otherwise `true`.
+
+template<typename Perm, typename F>
+bool for_each_support_point(const Perm &p, F f) {
+	static_assert(has_support<Perm>::value, "The permutation must be support aware.");
+	return detail::support_traits_of<Perm>::for_each(p, f);
+}
+
+// rst: .. function:: template<typename Perm> \
+// rst:               bool is_identity(const Perm &p, std::size_t n)
+// rst:
+// rst:		:returns: whether `p` fixes all elements in `[0, n[`.
+// rst:		  Only the support is checked if `p` is support aware.
+
+template<typename Perm>
+bool is_identity(const Perm &p, std::size_t n) {
+	BOOST_CONCEPT_ASSERT((Permutation<Perm>));
+	return detail::is_identity(p, n, has_support<Perm>());
+}
+
+// rst: .. function:: template<typename Perm> \
+// rst:               std::size_t first_moved(const Perm &p, std::size_t n)
+// rst:
+// rst:		:returns: the smallest element in `[0, n[` moved by `p`, or `n` if `p` is the identity.
+// rst:		  Only the support is checked if `p` is support aware.
+
+template<typename Perm>
+std::size_t first_moved(const Perm &p, std::size_t n) {
+	BOOST_CONCEPT_ASSERT((Permutation<Perm>));
+	return detail::first_moved(p, n, has_support<Perm>());
+}
+
+} // namespace perm_group
+
+#endif /* PERM_GROUP_PERMUTATION_SUPPORT_HPP */
@@ -59,7 +59,7 @@ public:
 	}
 
 	value_type get_(value_type i) const {
-		const auto *first = &perms[0];
+		const auto *first = perms.data();
 		const auto *last = first + perms.size();
 		return detail::permutation_word_get(first, last, i);
 	}
@@ -2,6 +2,7 @@
 #define PERM_GROUP_TRANSVERSAL_EXPLICIT_HPP
 
 #include <perm_group/orbit.hpp>
+#include <perm_group/permutation/materialize.hpp>
 #include <perm_group/permutation/mult.hpp>
 #include <perm_group/permutation/traits.hpp>
 
@@ -9,7 +10,14 @@ namespace perm_group {
 
 // rst: .. todo:: Actually write the documentation for this file.
 
-template<typename Alloc>
+// rst: .. class:: template<typename Alloc, template<typename> class InOrbitHandlerT = InOrbitHandlerVector> \
+// rst:            transversal_explicit
+// rst:
+// rst:		The `InOrbitHandlerT` must provide `position(u)`,
+// rst:		e.g., `InOrbitHandlerAdaptive` for large degrees with small orbits.
+// rst:
+
+template<typename Alloc, template<typename> class InOrbitHandlerT = InOrbitHandlerVector>
 struct transversal_explicit {
 public: // Transversal requirements
 	using allocator = Alloc;
@@ -19,7 +27,7 @@ public:
 	using pointer = typename allocator::pointer;
 	using const_pointer = typename allocator::const_pointer;
 public: // More Transversal requirements
-	using orbit_type = Orbit<value_type, InOrbitHandlerVector>;
+	using orbit_type = Orbit<value_type, InOrbitHandlerT>;
 public:
 
 	transversal_explicit(value_type w, const allocator &alloc) : alloc(alloc), orbit_(alloc.degree(), w) {
@@ -68,7 +76,7 @@ public:
 
 		const auto inner_onNewElement = [this, onNewElement](value_type u, value_type u_img, const GenPtrIter & iter_perm) {
 			const auto &trans_u = from_element(u);
-			const_pointer trans_u_img = alloc.copy(perm_group::mult(trans_u, **iter_perm));
+			const_pointer trans_u_img = perm_group::make_materialized(alloc, perm_group::mult(trans_u, **iter_perm));
 			perms.push_back(trans_u_img);
 			pred.push_back(u);
 			onNewElement(u, u_img, iter_perm, trans_u_img);
@@ -3,6 +3,8 @@
 
 #include <boost/iterator/transform_iterator.hpp>
 
+#include <cassert>
+
 namespace perm_group {
 
 // rst: This file contains convenience class templates for implementtors
@@ -0,0 +1,92 @@
+#ifndef PERM_GROUP_UTIL_SIMD_HPP
+#define PERM_GROUP_UTIL_SIMD_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace perm_group {
+namespace detail {
+
+// Gather kernels used for bulk evaluation of permutations stored as contiguous arrays.
+// The generic versions are plain loops, the AVX2 versions are selected by overloading
+// when the compiler targets AVX2 and the element type is a 32- or 64-bit integer.
+
+template<typename T, typename Idx>
+void gather(const T *table, const Idx *idx, T *out, std::size_t len) {
+	for(std::size_t j = 0; j != len; ++j)
+		out[j] = table[idx[j]];
+}
+
+#if defined(__AVX2__)
+
+template<typename T>
+using is_simd_gather_32 = std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 4>;
+template<typename T>
+using is_simd_gather_64 = std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) == 8>;
+
+template<typename T>
+typename std::enable_if<is_simd_gather_32<T>::value>::type
+gather(const T *table, const T *idx, T *out, std::size_t len) {
+	const int *base = reinterpret_cast<const int*> (table);
+	std::size_t j = 0;
+	for(; j + 8 <= len; j += 8) {
+		const __m256i vIdx = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (idx + j));
+		const __m256i vImg = _mm256_i32gather_epi32(base, vIdx, 4);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*> (out + j), vImg);
+	}
+	for(; j != len; ++j)
+		out[j] = table[idx[j]];
+}
+
+template<typename T>
+typename std::enable_if<is_simd_gather_64<T>::value>::type
+gather(const T *table, const T *idx, T *out, std::size_t len) {
+	const long long *base = reinterpret_cast<const long long*> (table);
+	std::size_t j = 0;
+	for(; j + 4 <= len; j += 4) {
+		const __m256i vIdx = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (idx + j));
+		const __m256i vImg = _mm256_i64gather_epi64(base, vIdx, 8);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*> (out + j), vImg);
+	}
+	for(; j != len; ++j)
+		out[j] = table[idx[j]];
+}
+
+#endif // __AVX2__
+
+template<typename T>
+void gather_inplace(const T *table, T *idx, std::size_t len) {
+	detail::gather(table, static_cast<const T*> (idx), idx, len);
+}
+
+template<typename T>
+void prefetch_l2(const T *p) {
+#if defined(__GNUC__)
+	__builtin_prefetch(p, 0, 2);
+#endif
+}
+
+// As gather_inplace, but after each chunk the entries of 'next' that the chunk will be looked up in
+// are prefetched, i.e., the part of the next table that a following gather_inplace(next, idx, len) touches.
+
+template<typename T>
+void gather_inplace_prefetch(const T *table, T *idx, std::size_t len, const T *next) {
+	constexpr std::size_t chunk = 64;
+	for(std::size_t first = 0; first < len; first += chunk) {
+		const std::size_t l = std::min(chunk, len - first);
+		detail::gather_inplace(table, idx + first, l);
+		for(std::size_t j = 0; j != l; ++j)
+			detail::prefetch_l2(next + idx[first + j]);
+	}
+}
+
+} // namespace detail
+} // namespace perm_group
+
+#endif /* PERM_GROUP_UTIL_SIMD_HPP */
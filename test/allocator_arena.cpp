@@ -0,0 +1,69 @@
+#include <perm_group/allocator/arena.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace pg = perm_group;
+
+using alloc_type = pg::arena_allocator<int>;
+using perm_type = alloc_type::perm;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	BOOST_CONCEPT_ASSERT((pg::DegreeAwarePermutation<perm_type>));
+	static_assert(pg::has_contiguous_images<const perm_type>::value, "");
+	static_assert(pg::has_rebind_degree<alloc_type>::value, "");
+	const std::size_t n = 37;
+	std::mt19937 engine(42);
+	// small slabs, to get several of them
+	alloc_type alloc(n, 1024);
+	std::vector<std::vector<int> > refs;
+	std::vector<alloc_type::pointer> ptrs;
+	for(std::size_t i = 0; i != 40; ++i) {
+		refs.push_back(pg::make_identity_perm<std::vector<int> >(n));
+		std::shuffle(refs.back().begin(), refs.back().end(), engine);
+		ptrs.push_back(alloc.copy(refs.back()));
+	}
+	BOOST_REQUIRE(alloc.num_slabs() > 1);
+	// rows are padded to cache lines, start on one, and are adjacent within a slab
+	BOOST_CHECK_EQUAL(pg::contiguous_images(*ptrs[1]) - pg::contiguous_images(*ptrs[0]), 48);
+	for(const auto *p : ptrs)
+		BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t> (pg::contiguous_images(*p)) % 64, 0);
+	// copies are independent of the arena, and assignment keeps the row
+	perm_type standalone(*ptrs[0]);
+	BOOST_CHECK(standalone == *ptrs[0]);
+	const int *row = pg::contiguous_images(*ptrs[0]);
+	*ptrs[0] = *ptrs[1];
+	BOOST_CHECK_EQUAL(pg::contiguous_images(*ptrs[0]), row);
+	*ptrs[0] = standalone;
+	// released permutations are reused
+	auto *identity = alloc.make_identity();
+	BOOST_CHECK(pg::is_identity(*identity, n));
+	alloc.release(identity);
+	BOOST_CHECK_EQUAL(alloc.make(), identity);
+	alloc.release(identity);
+	for(std::size_t i = 0; i < ptrs.size(); i += 2) {
+		alloc.release(ptrs[i]);
+		ptrs[i] = nullptr;
+	}
+	alloc.release(nullptr);
+	const std::size_t slabsBefore = alloc.num_slabs();
+	alloc.compact();
+	BOOST_CHECK(alloc.num_slabs() < slabsBefore);
+	for(std::size_t i = 0; i != ptrs.size(); ++i) {
+		if(!ptrs[i]) continue;
+		BOOST_CHECK(std::equal(refs[i].begin(), refs[i].end(), pg::contiguous_images(*ptrs[i])));
+	}
+	// released handles get new rows after compaction
+	for(std::size_t i = 0; i < ptrs.size(); i += 2)
+		ptrs[i] = alloc.copy(refs[i]);
+	for(std::size_t i = 0; i != ptrs.size(); ++i)
+		BOOST_CHECK(std::equal(refs[i].begin(), refs[i].end(), pg::contiguous_images(*ptrs[i])));
+}
@@ -0,0 +1,87 @@
+#include <perm_group/allocator/concurrent_pooled.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+using inner_type = pg::raw_ptr_allocator<perm_type>;
+using alloc_type = pg::concurrent_pooled_allocator<inner_type>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	static_assert(pg::has_rebind_degree<alloc_type>::value, "");
+	const std::size_t n = 20;
+	alloc_type alloc(4, 16, inner_type(n));
+	// released permutations are reused by the same thread
+	auto *p = alloc.make();
+	alloc.release(p);
+	BOOST_CHECK_EQUAL(alloc.make_identity(), p);
+	BOOST_CHECK(pg::is_identity(*p, n));
+	alloc.release(p);
+	alloc.release(nullptr);
+
+	// threads that only release hand their excess to threads that only allocate,
+	// and every thread checks that nobody else writes to its permutations
+	const std::size_t numThreads = 8, rounds = 2000;
+	std::atomic<std::size_t> failures(0);
+	std::vector<std::thread> threads;
+	for(std::size_t t = 0; t != numThreads; ++t) {
+		threads.emplace_back([alloc, t, n, &failures]() mutable {
+			std::mt19937 engine(t);
+			perm_type ref = pg::make_identity_perm<perm_type>(n);
+			std::vector<alloc_type::pointer> held;
+			for(std::size_t r = 0; r != rounds; ++r) {
+				std::shuffle(ref.begin(), ref.end(), engine);
+				held.push_back(alloc.copy(ref));
+				if(*held.back() != ref) ++failures;
+				if(t % 2 == 0 && held.size() > 10) {
+					for(auto *q : held) {
+						if(!std::is_permutation(q->begin(), q->end(), ref.begin())) ++failures;
+						alloc.release(q);
+					}
+					held.clear();
+				}
+			}
+			for(auto *q : held) alloc.release(q);
+		});
+	}
+	for(auto &t : threads) t.join();
+	BOOST_CHECK_EQUAL(failures, 0);
+
+	// a copy made in another thread is released by this thread's copy of the allocator
+	alloc_type::pointer fromOther = nullptr;
+	std::thread([&]() {
+		fromOther = alloc.make_identity();
+	}).join();
+	BOOST_CHECK(pg::is_identity(*fromOther, n));
+	alloc_type copy = alloc;
+	copy.release(fromOther);
+	auto rebound = alloc.rebind_degree(5);
+	BOOST_CHECK_EQUAL(rebound.degree(), 5);
+	auto *small = rebound.make_identity();
+	BOOST_CHECK_EQUAL(small->size(), 5);
+	rebound.release(small);
+
+	{ // the pool of an exited thread goes back to the global list, where a new allocator's thread finds it
+		alloc_type fresh(4, 16, inner_type(n));
+		alloc_type::pointer released = nullptr;
+		std::thread([&]() {
+			released = fresh.make();
+			fresh.release(released);
+		}).join();
+		auto *q = fresh.make();
+		BOOST_CHECK_EQUAL(q, released);
+		fresh.release(q);
+	}
+}
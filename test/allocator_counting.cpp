@@ -0,0 +1,83 @@
+#include <perm_group/allocator/counting.hpp>
+#include <perm_group/allocator/pooled.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+using raw_type = pg::raw_ptr_allocator<perm_type>;
+using pooled_type = pg::pooled_allocator<raw_type>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	using alloc_type = pg::counting_allocator<pooled_type>;
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	BOOST_CONCEPT_ASSERT((pg::Allocator<pg::counting_allocator<raw_type, false> >));
+	static_assert(pg::has_rebind_degree<alloc_type>::value, "");
+	const std::size_t n = 10;
+	alloc_type alloc{pooled_type(4, raw_type(n))};
+	auto *a = alloc.make();
+	auto *b = alloc.make_identity();
+	auto *c = alloc.copy(*b);
+	alloc.release(a);
+	alloc.release(nullptr);
+	auto *d = alloc.make();
+	const auto &st = alloc.stats();
+	BOOST_CHECK_EQUAL(st.makes, 2);
+	BOOST_CHECK_EQUAL(st.make_identities, 1);
+	BOOST_CHECK_EQUAL(st.copies, 1);
+	BOOST_CHECK_EQUAL(st.releases, 1);
+	BOOST_CHECK_EQUAL(st.live, 3);
+	BOOST_CHECK_EQUAL(st.peak_live, 3);
+	BOOST_CHECK_EQUAL(st.live_bytes, 3 * (sizeof(perm_type) + n * sizeof(int)));
+	BOOST_CHECK_EQUAL(st.pool_hits, 1);
+	BOOST_CHECK_EQUAL(st.pool_misses, 3);
+	// the disabled variant has the same interface, and never counts
+	pg::counting_allocator<raw_type, false> off{raw_type(n)};
+	const pg::allocation_stats &offStats = off.stats();
+	off.release(off.make());
+	BOOST_CHECK_EQUAL(offStats.makes, 0);
+	// copies and rebound allocators share the counters
+	alloc_type copy = alloc;
+	copy.release(d);
+	auto rebound = alloc.rebind_degree(3);
+	auto *e = rebound.make();
+	BOOST_CHECK_EQUAL(st.live, 3);
+	BOOST_CHECK_EQUAL(st.live_bytes, 2 * (sizeof(perm_type) + n * sizeof(int)) + sizeof(perm_type) + 3 * sizeof(int));
+	rebound.release(e);
+	alloc.release(b);
+	alloc.release(c);
+	BOOST_CHECK_EQUAL(st.live, 0);
+	BOOST_CHECK_EQUAL(st.live_bytes, 0);
+	BOOST_CHECK_EQUAL(st.peak_live, 3);
+	std::ostringstream ss;
+	ss << st;
+	BOOST_CHECK(ss.str().find("hit rate") != std::string::npos);
+	alloc.reset_stats();
+	BOOST_CHECK_EQUAL(st.makes, 0);
+	BOOST_CHECK_EQUAL(st.peak_live, 0);
+
+	// a group releases everything it allocates
+	using system = pg::generating_system<pg::transversal_explicit<pg::counting_allocator<raw_type> > >;
+	pg::counting_allocator<raw_type> gAlloc{raw_type(8)};
+	{
+		system g(gAlloc);
+		g.add_generator(perm_type{1, 2, 3, 0, 4, 5, 6, 7});
+		g.add_generator(perm_type{0, 1, 2, 3, 5, 4, 6, 7});
+		BOOST_CHECK(g.is_member(perm_type{3, 0, 1, 2, 5, 4, 6, 7}));
+		BOOST_CHECK(g.get_allocator().stats().live > 0);
+		BOOST_CHECK_EQUAL(g.get_allocator().stats().live, gAlloc.stats().live);
+	}
+	BOOST_CHECK(gAlloc.stats().peak_live > 0);
+	BOOST_CHECK_EQUAL(gAlloc.stats().live, 0);
+	BOOST_CHECK_EQUAL(gAlloc.stats().makes + gAlloc.stats().make_identities + gAlloc.stats().copies,
+			gAlloc.stats().releases);
+}
@@ -0,0 +1,75 @@
+#include <perm_group/allocator/interning.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/allocator/shared_ptr.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/support.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+
+template<typename Inner>
+void testSharing() {
+	using alloc_type = pg::interning_allocator<Inner>;
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	static_assert(pg::has_rebind_degree<alloc_type>::value, "");
+	const std::size_t n = 6;
+	alloc_type alloc{Inner(n)};
+	const perm_type a = {1, 0, 2, 3, 4, 5}, b = {0, 1, 2, 3, 5, 4};
+	// equal permutations are shared
+	auto id1 = alloc.make_identity();
+	auto id2 = alloc.copy(pg::make_identity_perm<perm_type>(n));
+	BOOST_CHECK(id1 == id2);
+	BOOST_CHECK(pg::is_identity(*id1, n));
+	auto a1 = alloc.copy(a);
+	auto a2 = alloc.copy(a);
+	auto b1 = alloc.copy(b);
+	BOOST_CHECK(a1 == a2);
+	BOOST_CHECK(a1 != b1);
+	BOOST_CHECK_EQUAL(alloc.num_shared(), 3);
+	BOOST_CHECK_EQUAL(alloc.use_count(a1), 2);
+	// a written permutation can be shared afterwards
+	auto scratch = alloc.make();
+	for(std::size_t i = 0; i != n; ++i) pg::put(*scratch, i, a[i]);
+	BOOST_CHECK_EQUAL(alloc.use_count(scratch), 0);
+	auto a3 = alloc.intern(scratch);
+	BOOST_CHECK(a3 == a1);
+	BOOST_CHECK_EQUAL(alloc.use_count(a1), 3);
+	// released permutations stay until the last reference is released
+	alloc.release(a1);
+	alloc.release(a2);
+	BOOST_CHECK(*a3 == a);
+	alloc.release(a3);
+	BOOST_CHECK_EQUAL(alloc.num_shared(), 2);
+	alloc.release(id1);
+	alloc.release(id2);
+	alloc.release(b1);
+	BOOST_CHECK_EQUAL(alloc.num_shared(), 0);
+	// non-shared permutations are passed through
+	auto fresh = alloc.make();
+	alloc.release(fresh);
+	BOOST_CHECK_EQUAL(alloc.num_shared(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	testSharing<pg::raw_ptr_allocator<perm_type> >();
+	testSharing<pg::shared_ptr_allocator<perm_type> >();
+
+	// the identities of all levels of a chain are shared
+	const std::size_t n = 8;
+	using alloc_type = pg::interning_allocator<pg::raw_ptr_allocator<perm_type> >;
+	using system = pg::generating_system<pg::transversal_explicit<alloc_type> >;
+	alloc_type alloc{pg::raw_ptr_allocator<perm_type>(n)};
+	system g(alloc);
+	const perm_type a = {1, 2, 3, 0, 4, 5, 7, 6}, b = {0, 1, 2, 3, 5, 4, 6, 7};
+	for(const auto &gen :{a, b}) g.add_generator(gen);
+	auto id = alloc.make_identity();
+	BOOST_CHECK(alloc.use_count(id) > 2);
+	alloc.release(id);
+}
@@ -0,0 +1,80 @@
+#include "util.hpp"
+
+#include <perm_group/allocator/mmap.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include <unistd.h>
+
+namespace pg = perm_group;
+
+using alloc_type = pg::mmap_allocator<int>;
+using perm_type = alloc_type::perm;
+
+void testOptions(const pg::mmap_slabs::options &opts) {
+	const std::size_t n = 1000;
+	std::mt19937 engine(42);
+	alloc_type alloc(n, 1 << 16, pg::mmap_slabs(opts));
+	std::vector<std::vector<int> > refs;
+	std::vector<alloc_type::pointer> ptrs;
+	// more than one huge page of permutations
+	for(std::size_t i = 0; i != 600; ++i) {
+		refs.push_back(pg::make_identity_perm<std::vector<int> >(n));
+		std::shuffle(refs.back().begin(), refs.back().end(), engine);
+		ptrs.push_back(alloc.copy(refs.back()));
+	}
+	BOOST_CHECK(alloc.num_slabs() > 1);
+	if(opts.pages != pg::mmap_slabs::huge_pages::none) {
+		// slabs with huge pages are aligned, so they can be backed by them
+		pg::mmap_slabs slabs(opts);
+		const std::size_t bytes = slabs.round_size(1);
+		void *p = slabs.allocate(bytes);
+		BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t> (p) % pg::mmap_slabs::huge_page_size(), 0);
+		slabs.deallocate(p, bytes);
+	}
+	for(std::size_t i = 0; i < ptrs.size(); i += 2) {
+		alloc.release(ptrs[i]);
+		ptrs[i] = nullptr;
+	}
+	alloc.compact();
+	for(std::size_t i = 0; i != ptrs.size(); ++i) {
+		if(!ptrs[i]) continue;
+		BOOST_CHECK(std::equal(refs[i].begin(), refs[i].end(), pg::contiguous_images(*ptrs[i])));
+	}
+
+	// a group on the slabs agrees with one on separately allocated permutations
+	const std::size_t m = 10;
+	// only shuffle the first half, so the group is a proper subgroup
+	std::vector<std::vector<int> > small;
+	for(std::size_t i = 0; i != 10; ++i) {
+		small.push_back(pg::make_identity_perm<std::vector<int> >(m));
+		std::shuffle(small.back().begin(), small.back().begin() + m / 2, engine);
+	}
+	small.push_back(pg::make_identity_perm<std::vector<int> >(m));
+	std::swap(small.back()[0], small.back()[m - 1]);
+	const std::vector<std::vector<int> > gens(small.begin(), small.begin() + 2);
+	BOOST_CHECK(sameMembership(alloc_type(m, 1 << 16, pg::mmap_slabs(opts)), gens, small));
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	pg::mmap_slabs::options opts;
+	BOOST_CHECK_EQUAL(pg::mmap_slabs(opts).round_size(1), pg::mmap_slabs::huge_page_size());
+	testOptions(opts);
+	opts.pages = pg::mmap_slabs::huge_pages::none;
+	opts.populate = true;
+	BOOST_CHECK_EQUAL(pg::mmap_slabs(opts).round_size(1), static_cast<std::size_t> (sysconf(_SC_PAGESIZE)));
+	testOptions(opts);
+	opts.pages = pg::mmap_slabs::huge_pages::explicit_;
+	testOptions(opts);
+	// file backed, and the file is removed right away
+	opts.file = "perm_group_test_allocator_mmap." + std::to_string(getpid());
+	testOptions(opts);
+	BOOST_CHECK(access(opts.file.c_str(), F_OK) != 0);
+}
@@ -0,0 +1,78 @@
+#include "util.hpp"
+
+#include <perm_group/allocator/pmr.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace pg = perm_group;
+
+// A monotonic resource that counts its calls.
+struct CountingResource : pg::pmr::memory_resource {
+	~CountingResource() {
+		for(void *p : blocks) ::operator delete(p);
+	}
+private:
+
+	void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+		++allocs;
+		blocks.push_back(::operator new(bytes));
+		return blocks.back();
+	}
+
+	void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+		++deallocs;
+	}
+
+	bool do_is_equal(const pg::pmr::memory_resource &other) const noexcept override {
+		return this == &other;
+	}
+public:
+	std::size_t allocs = 0, deallocs = 0;
+	std::vector<void*> blocks;
+};
+
+using perm_type = std::vector<int, pg::pmr::polymorphic_allocator<int> >;
+using alloc_type = pg::pmr_allocator<perm_type>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	BOOST_CONCEPT_ASSERT((pg::Allocator<pg::pmr_allocator<std::vector<int> > >));
+	const std::size_t n = 8;
+	{ // both the permutation and its images come from the resource
+		CountingResource res;
+		alloc_type alloc(n, &res);
+		auto *p = alloc.make_identity();
+		BOOST_CHECK(pg::is_identity(*p, n));
+		BOOST_CHECK(p->get_allocator().resource() == &res);
+		BOOST_CHECK_EQUAL(res.allocs, 2);
+		const std::vector<int> ref = {1, 0, 3, 2, 5, 4, 7, 6};
+		auto *q = alloc.copy(ref);
+		BOOST_CHECK(std::equal(ref.begin(), ref.end(), q->begin()));
+		alloc.release(p);
+		alloc.release(q);
+		BOOST_CHECK_EQUAL(res.allocs, res.deallocs);
+	}
+
+	// the permutations of a group come from the resource, and are only given back when destroying
+	const std::vector<std::vector<int> > gens = {
+		{1, 2, 3, 0, 4, 5, 6, 7},
+		{0, 1, 2, 3, 5, 4, 6, 7}
+	}, elems = {
+		{0, 1, 2, 3, 4, 5, 7, 6},
+		{3, 0, 1, 2, 5, 4, 6, 7}
+	};
+	for(bool destroy :{true, false}) {
+		CountingResource res;
+		BOOST_CHECK(sameMembership(alloc_type(n, &res, destroy), gens, elems));
+		BOOST_CHECK(res.allocs > 0);
+		if(destroy) BOOST_CHECK_EQUAL(res.allocs, res.deallocs);
+		else BOOST_CHECK_EQUAL(res.deallocs, 0);
+	}
+}
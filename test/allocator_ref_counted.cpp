@@ -0,0 +1,67 @@
+#include <perm_group/allocator/ref_counted.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+
+template<bool Atomic>
+void testPointers() {
+	using alloc_type = pg::ref_counted_allocator<perm_type, Atomic>;
+	BOOST_CONCEPT_ASSERT((pg::Allocator<alloc_type>));
+	static_assert(sizeof(typename alloc_type::pointer) == sizeof(void*), "");
+	const std::size_t n = 10;
+	alloc_type alloc(n);
+	typename alloc_type::pointer p = alloc.make_identity();
+	BOOST_CHECK(pg::is_identity(*p, n));
+	BOOST_CHECK_EQUAL(p.use_count(), 1);
+	{
+		typename alloc_type::const_pointer cp = p;
+		BOOST_CHECK(cp == p);
+		BOOST_CHECK_EQUAL(p.use_count(), 2);
+		auto moved = std::move(cp);
+		BOOST_CHECK(!cp);
+		BOOST_CHECK(cp == nullptr);
+		BOOST_CHECK_EQUAL(moved->size(), n);
+		BOOST_CHECK_EQUAL(p.use_count(), 2);
+	}
+	BOOST_CHECK_EQUAL(p.use_count(), 1);
+	auto q = alloc.copy(*p);
+	BOOST_CHECK(q != p);
+	BOOST_CHECK(*q == *p);
+	q = p;
+	BOOST_CHECK_EQUAL(p.use_count(), 2);
+	alloc.release(std::move(q));
+	BOOST_CHECK_EQUAL(p.use_count(), 1);
+	typename alloc_type::pointer empty;
+	BOOST_CHECK_EQUAL(empty.use_count(), 0);
+	BOOST_CHECK(empty.get() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	testPointers<false>();
+	testPointers<true>();
+
+	// the atomic variant may be copied concurrently
+	using atomic_alloc = pg::ref_counted_allocator<perm_type, true>;
+	atomic_alloc alloc(5);
+	auto p = alloc.make_identity();
+	std::vector<std::thread> threads;
+	for(std::size_t t = 0; t != 4; ++t) {
+		threads.emplace_back([p]() {
+			for(std::size_t i = 0; i != 10000; ++i) {
+				atomic_alloc::const_pointer cp = p;
+				(void) cp;
+			}
+		});
+	}
+	for(auto &t : threads) t.join();
+	BOOST_CHECK_EQUAL(p.use_count(), 1);
+}
@@ -0,0 +1,79 @@
+#include <perm_group/permutation/apply.hpp>
+#include <perm_group/permutation/array.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/sparse.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <random>
+
+namespace pg = perm_group;
+
+template<typename Perm>
+void testApply(std::size_t n, std::size_t m) {
+	using value_type = typename pg::permutation_traits<Perm>::value_type;
+	std::mt19937 engine(n + m);
+	std::vector<Perm> ps;
+	std::vector<std::vector<value_type> > images;
+	for(int k = 0; k != 3; ++k) {
+		images.emplace_back(n);
+		std::iota(images.back().begin(), images.back().end(), 0);
+		std::shuffle(images.back().begin(), images.back().end(), engine);
+		ps.push_back(pg::make_perm<Perm>(n));
+		for(std::size_t i = 0; i != n; ++i) pg::put(ps.back(), i, images.back()[i]);
+	}
+	std::vector<value_type> points(m);
+	for(auto &x : points) x = engine() % n;
+	std::vector<value_type> expected(m);
+	for(std::size_t j = 0; j != m; ++j) expected[j] = images[0][points[j]];
+
+	std::vector<value_type> out(m);
+	BOOST_REQUIRE(pg::apply(ps[0], points.data(), points.data() + m, out.data()) == out.data() + m);
+	BOOST_REQUIRE(out == expected);
+	// generic iterators
+	std::list<value_type> outList;
+	pg::apply(ps[0], points.begin(), points.end(), std::back_inserter(outList));
+	BOOST_REQUIRE(std::equal(outList.begin(), outList.end(), expected.begin()));
+	std::vector<value_type> inplace = points;
+	pg::apply_inplace(ps[0], inplace.data(), inplace.data() + m);
+	BOOST_REQUIRE(inplace == expected);
+
+	std::vector<value_type> set = points;
+	std::sort(set.begin(), set.end());
+	set.erase(std::unique(set.begin(), set.end()), set.end());
+	std::vector<value_type> setImage;
+	pg::apply_sorted_set(ps[0], set.begin(), set.end(), std::back_inserter(setImage));
+	std::vector<value_type> expectedSet = expected;
+	std::sort(expectedSet.begin(), expectedSet.end());
+	expectedSet.erase(std::unique(expectedSet.begin(), expectedSet.end()), expectedSet.end());
+	BOOST_REQUIRE(setImage == expectedSet);
+
+	boost::dynamic_bitset<> bits(n), bitsImage;
+	for(const auto x : set) bits.set(x);
+	pg::apply_set(ps[0], bits, bitsImage);
+	BOOST_REQUIRE_EQUAL(bitsImage.count(), expectedSet.size());
+	for(const auto x : expectedSet) BOOST_REQUIRE(bitsImage.test(x));
+
+	std::vector<const Perm*> ptrs;
+	for(const auto &p : ps) ptrs.push_back(&p);
+	std::vector<value_type> multi(ps.size() * m);
+	pg::apply_multi(ptrs.begin(), ptrs.end(), points.data(), points.data() + m, multi.data());
+	for(std::size_t k = 0; k != ps.size(); ++k)
+		for(std::size_t j = 0; j != m; ++j)
+			BOOST_REQUIRE_EQUAL(multi[k * m + j], images[k][points[j]]);
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	for(std::size_t n : {5, 100, 3000}) {
+		for(std::size_t m : {0, 1, 7, 50, 10000}) {
+			testApply<std::vector<int> >(n, m);
+			testApply<std::vector<std::size_t> >(n, m);
+			testApply<pg::sparse_permutation<unsigned int> >(n, m);
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/cycles.hpp>
+#include <perm_group/permutation/io.hpp>
+#include <perm_group/permutation/mult.hpp>
+#include <perm_group/permutation/sparse.hpp>
+#include <perm_group/permutation/support.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+namespace pg = perm_group;
+
+template<typename Perm>
+Perm naivePower(const Perm &p, long long k, std::size_t n) {
+	const Perm base = k < 0 ? pg::make_inverse(p) : p;
+	Perm res = pg::make_identity_perm<Perm>(n);
+	for(long long i = 0; i != (k < 0 ? -k : k); ++i)
+		res = pg::copy_perm<Perm>(n, pg::mult(res, base));
+	return res;
+}
+
+template<typename Perm>
+void testPerm(std::size_t n) {
+	std::mt19937 engine(42);
+	for(int round = 0; round != 20; ++round) {
+		std::vector<std::size_t> images(n);
+		for(std::size_t i = 0; i != n; ++i) images[i] = i;
+		std::shuffle(images.begin(), images.end() - n / 3, engine);
+		Perm p = pg::make_perm<Perm>(n);
+		for(std::size_t i = 0; i != n; ++i) pg::put(p, i, images[i]);
+
+		const auto cd = pg::make_cycle_decomposition(p, n);
+		std::stringstream sCycles, sPerm;
+		sCycles << cd;
+		pg::write_permutation_cycles(sPerm, p, n);
+		BOOST_REQUIRE_EQUAL(sCycles.str(), sPerm.str());
+
+		const auto type = cd.cycle_type();
+		BOOST_REQUIRE(std::is_sorted(type.rbegin(), type.rend()));
+		std::size_t moved = 0;
+		for(const auto len : type) moved += len;
+		BOOST_REQUIRE_EQUAL(moved, cd.support_size());
+
+		const auto ord = cd.order();
+		BOOST_REQUIRE(pg::is_identity(pg::power(p, ord, n), n));
+		for(std::size_t len = 1; len != ord; ++len)
+			if(ord % len == 0) BOOST_REQUIRE(!pg::is_identity(pg::power(p, len, n), n));
+
+		for(const long long k : {0ll, 1ll, 2ll, 7ll, -1ll, -5ll}) {
+			const Perm pk = pg::power(p, k, n);
+			const Perm expected = naivePower(p, k, n);
+			for(std::size_t i = 0; i != n; ++i)
+				BOOST_REQUIRE_EQUAL(pg::get(pk, i), pg::get(expected, i));
+		}
+		// huge exponents reduce modulo the order
+		const Perm big = pg::power(p, std::numeric_limits<std::uintmax_t>::max(), n);
+		const Perm reduced = pg::power(p, std::numeric_limits<std::uintmax_t>::max() % ord, n);
+		const Perm bigNeg = pg::power(p, std::numeric_limits<long long>::min(), n);
+		const Perm reducedNeg = pg::make_inverse(pg::power(p, static_cast<std::uintmax_t>(std::numeric_limits<long long>::max()) % ord + 1, n));
+		for(std::size_t i = 0; i != n; ++i) {
+			BOOST_REQUIRE_EQUAL(pg::get(big, i), pg::get(reduced, i));
+			BOOST_REQUIRE_EQUAL(pg::get(bigNeg, i), pg::get(reducedNeg, i));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	testPerm<std::vector<int> >(30);
+	testPerm<std::vector<std::size_t> >(100);
+	testPerm<std::vector<unsigned int> >(57);
+	testPerm<pg::sparse_permutation<int> >(40);
+
+	std::vector<int> p(10);
+	pg::read_permutation_cycles("(0 1 2)(3 4)(5 6 7 8 9)", p);
+	BOOST_REQUIRE_EQUAL(pg::order(p), 30);
+	BOOST_REQUIRE(pg::cycle_type(p) == std::vector<std::size_t>({5, 3, 2}));
+	BOOST_REQUIRE_EQUAL(pg::make_cycle_decomposition(pg::make_identity_perm<std::vector<int> >(10)).order(), 1);
+
+	// small value types are written as numbers
+	std::vector<unsigned char> q(70);
+	pg::read_permutation_cycles("(0 65)(66 67 68)", q);
+	std::stringstream sCycles, sPerm;
+	sCycles << pg::make_cycle_decomposition(q);
+	pg::write_permutation_cycles(sPerm, q);
+	BOOST_REQUIRE_EQUAL(sCycles.str(), "(0 65)(66 67 68)");
+	BOOST_REQUIRE_EQUAL(sPerm.str(), "(0 65)(66 67 68)");
+}
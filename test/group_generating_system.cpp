@@ -0,0 +1,109 @@
+#include <perm_group/allocator/pooled.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/allocator/shared_ptr.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+
+// a random permutation of degree n moving elements from [first, first + k[
+perm_type makeRandomOnRange(std::mt19937 &engine, std::size_t n, std::size_t first, std::size_t k) {
+	perm_type p = pg::make_identity_perm<perm_type>(n);
+	std::shuffle(p.begin() + first, p.begin() + first + k, engine);
+	return p;
+}
+
+struct base_point_last_moved {
+
+	template<typename Perm>
+	typename pg::permutation_traits<Perm>::value_type operator()(const Perm &p) const {
+		for(std::size_t i = pg::degree(p); i != 0; --i)
+			if(pg::get(p, i - 1) != i - 1)
+				return i - 1;
+		return 0;
+	}
+};
+
+template<typename BasePointProvider, typename Alloc>
+void test(const Alloc &alloc) {
+	using transversal = pg::transversal_explicit<Alloc>;
+	using system = pg::generating_system<transversal, BasePointProvider, true>;
+	using chain_type = pg::stabilizer_chain<transversal, BasePointProvider>;
+	static_assert(pg::has_rebind_degree<Alloc>::value, "");
+	const std::size_t n = alloc.degree();
+	std::mt19937 engine(42);
+	for(int round = 0; round != 3; ++round) {
+		system g(alloc);
+		// the reference, without compression
+		std::unique_ptr<chain_type> chain;
+		pg::generated_group<Alloc> gRef(alloc);
+		std::vector<perm_type> gens;
+		// grow the support with each generator, then add some within the support
+		const std::size_t offsets[] = {100, 120, 90, 100, 105};
+		for(const std::size_t first : offsets) {
+			gens.push_back(makeRandomOnRange(engine, n, first, 20));
+			g.add_generator(gens.back());
+			gRef.add_generator(gens.back(), [&](auto first, auto lastOld, auto lastNew) {
+				if(!chain) chain.reset(new chain_type(BasePointProvider()(**lastOld), alloc));
+				chain->add_generators(first, lastOld, lastNew);
+			});
+			BOOST_REQUIRE(g.compact_degree() < n);
+			BOOST_REQUIRE(g.degree() == n);
+			for(int i = 0; i != 20; ++i) {
+				perm_type member = pg::make_identity_perm<perm_type>(n);
+				for(int j = 0; j != 5; ++j)
+					member = pg::copy_perm<perm_type>(pg::mult(member, gens[engine() % gens.size()]));
+				BOOST_REQUIRE(g.is_member(member));
+				BOOST_REQUIRE(chain->is_member_of_parent(member));
+				const perm_type other = makeRandomOnRange(engine, n, 85, 60);
+				BOOST_REQUIRE_EQUAL(g.is_member(other), chain->is_member_of_parent(other));
+				const perm_type outside = makeRandomOnRange(engine, n, 300, 10);
+				BOOST_REQUIRE(!g.is_member(outside));
+			}
+		}
+		// the generators are reported in the original labels, though redundant ones are skipped
+		const auto gs = g.generators();
+		BOOST_REQUIRE(gs.size() > 1);
+		auto iter = gens.begin();
+		for(std::size_t i = 1; i != gs.size(); ++i) {
+			iter = std::find(iter, gens.end(), gs[i]);
+			BOOST_REQUIRE(iter != gens.end());
+		}
+	}
+	{ // a support covering everything falls back to the original domain
+		system g(alloc);
+		perm_type a = pg::make_identity_perm<perm_type>(n);
+		std::rotate(a.begin(), a.begin() + 1, a.begin() + n / 2);
+		g.add_generator(a);
+		BOOST_REQUIRE(g.compact_degree() == n / 2);
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::rotate(p.begin() + n / 2, p.begin() + n / 2 + 1, p.end());
+		g.add_generator(p);
+		BOOST_REQUIRE(g.compact_degree() == n);
+		BOOST_REQUIRE(g.is_member(p));
+	}
+	{ // without opting in, the chain stays on the original domain
+		pg::generating_system<transversal, BasePointProvider> g(alloc);
+		g.add_generator(makeRandomOnRange(engine, n, 100, 20));
+		BOOST_REQUIRE(g.compact_degree() == n);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	const std::size_t n = 400;
+	test<pg::base_point_first_moved>(pg::raw_ptr_allocator<perm_type>(n));
+	test<base_point_last_moved>(pg::raw_ptr_allocator<perm_type>(n));
+	test<pg::base_point_first_moved>(pg::shared_ptr_allocator<perm_type>(n));
+	using pooled = pg::pooled_allocator<pg::raw_ptr_allocator<perm_type> >;
+	test<pg::base_point_first_moved>(pooled(10, pg::raw_ptr_allocator<perm_type>(n)));
+}
@@ -0,0 +1,105 @@
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generated.hpp>
+#include <perm_group/group/stabilizer_chain.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/io.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+using alloc_type = pg::raw_ptr_allocator<perm_type>;
+using chain_type = pg::stabilizer_chain<pg::transversal_explicit<alloc_type> >;
+
+perm_type makeRandom(std::mt19937 &engine, std::size_t n) {
+	perm_type p = pg::make_identity_perm<perm_type>(n);
+	std::shuffle(p.begin(), p.end(), engine);
+	return p;
+}
+
+std::unique_ptr<chain_type> makeChain(pg::generated_group<alloc_type> &group, const std::vector<perm_type> &gens) {
+	std::unique_ptr<chain_type> chain;
+	for(const auto &g : gens) {
+		group.add_generator(g, [&](auto first, auto lastOld, auto lastNew) {
+			if(!chain) chain.reset(new chain_type(pg::base_point_first_moved()(**lastOld), group.get_allocator()));
+			chain->add_generators(first, lastOld, lastNew);
+		});
+	}
+	return chain;
+}
+
+BOOST_AUTO_TEST_CASE(test_cyclic) {
+	const std::size_t n = 10;
+	perm_type p(n), q(n);
+	pg::read_permutation_cycles("(0 1 2 3 4)(5 6)", p);
+	pg::generated_group<alloc_type> group(alloc_type{n});
+	auto chain = makeChain(group, {p});
+	chain->build_invariant_filter(1000);
+	const auto &filter = *chain->get_invariant_filter();
+	BOOST_REQUIRE(filter.has_cycle_types());
+	BOOST_REQUIRE_EQUAL(filter.group_order(), 10);
+	BOOST_REQUIRE(filter.element_orders() == std::set<std::uintmax_t>({1, 2, 5, 10}));
+	BOOST_REQUIRE_EQUAL(filter.cycle_types().size(), 4);
+	BOOST_REQUIRE_EQUAL(filter.orbit_id(3), 0);
+	BOOST_REQUIRE_EQUAL(filter.orbit_id(6), 5);
+	BOOST_REQUIRE_EQUAL(filter.orbit_id(9), 9);
+	// wrong orbit
+	pg::read_permutation_cycles("(0 5)", q);
+	BOOST_REQUIRE(!filter.accepts(q));
+	// right orbits, wrong cycle type
+	pg::read_permutation_cycles("(0 1)(2 3)", q);
+	BOOST_REQUIRE(!filter.accepts(q));
+	// right cycle type, but not a member
+	pg::read_permutation_cycles("(0 2 1 3 4)", q);
+	BOOST_REQUIRE(filter.accepts(q));
+	BOOST_REQUIRE(!chain->is_member_of_parent(q));
+	for(int k = 0; k != 10; ++k)
+		BOOST_REQUIRE(chain->is_member_of_parent(pg::power(p, k)));
+
+	chain->clear_invariant_filter();
+	BOOST_REQUIRE(!chain->get_invariant_filter());
+}
+
+BOOST_AUTO_TEST_CASE(test_random) {
+	std::mt19937 engine(42);
+	for(const std::size_t n : {6, 8, 12}) {
+		for(int round = 0; round != 10; ++round) {
+			// a group with a few orbits, so both checks are exercised
+			std::vector<perm_type> gens;
+			for(int i = 0; i != 2; ++i) {
+				perm_type g = pg::make_identity_perm<perm_type>(n);
+				std::shuffle(g.begin(), g.begin() + n / 2, engine);
+				std::shuffle(g.begin() + n / 2 + 1, g.end(), engine);
+				gens.push_back(g);
+			}
+			pg::generated_group<alloc_type> group(alloc_type{n}), referenceGroup(alloc_type{n});
+			auto chain = makeChain(group, gens);
+			auto reference = makeChain(referenceGroup, gens);
+			chain->build_invariant_filter(100000);
+			BOOST_REQUIRE(chain->get_invariant_filter());
+			std::size_t rejected = 0;
+			for(int i = 0; i != 200; ++i) {
+				const perm_type p = makeRandom(engine, n);
+				const bool isMember = reference->is_member_of_parent(p);
+				BOOST_REQUIRE_EQUAL(chain->is_member_of_parent(p), isMember);
+				if(!chain->get_invariant_filter()->accepts(p)) {
+					BOOST_REQUIRE(!isMember);
+					++rejected;
+				}
+				perm_type member = pg::make_identity_perm<perm_type>(n);
+				for(int j = 0; j != 5; ++j)
+					member = pg::copy_perm<perm_type>(pg::mult(member, gens[engine() % gens.size()]));
+				BOOST_REQUIRE(chain->get_invariant_filter()->accepts(member));
+				BOOST_REQUIRE(chain->is_member_of_parent(member));
+			}
+			BOOST_REQUIRE(rejected > 0);
+		}
+	}
+}
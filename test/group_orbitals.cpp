@@ -0,0 +1,90 @@
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generated.hpp>
+#include <perm_group/group/orbitals.hpp>
+#include <perm_group/group/stabilizer_chain.hpp>
+#include <perm_group/orbit/action.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/io.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <map>
+#include <set>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+using alloc_type = pg::raw_ptr_allocator<perm_type>;
+using chain_type = pg::stabilizer_chain<pg::transversal_explicit<alloc_type> >;
+using pair_type = std::array<int, 2>;
+
+void check(const std::size_t n, const std::vector<std::string> &cycles) {
+	std::vector<perm_type> gens;
+	for(const auto &c : cycles) {
+		gens.emplace_back(n);
+		pg::read_permutation_cycles(c, gens.back());
+	}
+	pg::generated_group<alloc_type> group(alloc_type{n});
+	std::unique_ptr<chain_type> chain;
+	for(const auto &g : gens) {
+		group.add_generator(g, [&](auto first, auto lastOld, auto lastNew) {
+			if(!chain) chain.reset(new chain_type(pg::base_point_first_moved()(**lastOld), group.get_allocator()));
+			chain->add_generators(first, lastOld, lastNew);
+		});
+	}
+	BOOST_REQUIRE(chain);
+	const pg::orbital_decomposition<chain_type> orbitals(*chain);
+
+	// the reference, by the orbits on all pairs
+	std::vector<const perm_type*> ptrs;
+	for(const auto &g : gens) ptrs.push_back(&g);
+	std::map<pair_type, std::size_t> refOrbit;
+	std::vector<std::size_t> refSize;
+	for(int u = 0; u != n; ++u) {
+		for(int v = 0; v != n; ++v) {
+			if(refOrbit.count(pair_type{{u, v}})) continue;
+			const auto o = pg::make_action_orbit(pair_type{{u, v}}, ptrs.begin(), ptrs.end(), pg::action_on_tuples());
+			for(const auto &p : o) refOrbit[p] = refSize.size();
+			refSize.push_back(o.size());
+		}
+	}
+	BOOST_REQUIRE_EQUAL(orbitals.num_orbitals(), refSize.size());
+	std::vector<std::size_t> total(orbitals.num_orbitals());
+	std::set<pair_type> seen;
+	orbitals.for_each_edge([&](std::size_t i, int u, int v) {
+		BOOST_REQUIRE(seen.insert(pair_type{{u, v}}).second);
+		BOOST_REQUIRE_EQUAL(orbitals.orbital_of(u, v), i);
+		++total[i];
+	});
+	BOOST_REQUIRE_EQUAL(seen.size(), n * n);
+	for(std::size_t i = 0; i != orbitals.num_orbitals(); ++i) {
+		const auto &o = orbitals.orbitals()[i];
+		BOOST_REQUIRE_EQUAL(o.size, total[i]);
+		const pair_type rep = {{o.first, o.second}};
+		BOOST_REQUIRE_EQUAL(o.size, refSize[refOrbit[rep]]);
+		BOOST_REQUIRE_EQUAL(orbitals.orbital_of(o.first, o.second), i);
+		const std::size_t p = orbitals.paired(i);
+		BOOST_REQUIRE_EQUAL(orbitals.orbital_of(o.second, o.first), p);
+		BOOST_REQUIRE_EQUAL(orbitals.paired(p), i);
+	}
+	// same orbital iff same orbit on pairs
+	for(int u = 0; u != n; ++u)
+		for(int v = 0; v != n; ++v)
+			for(const int x : {0, 3})
+				for(int y = 0; y != n; ++y)
+					BOOST_REQUIRE_EQUAL(orbitals.orbital_of(u, v) == orbitals.orbital_of(x, y),
+						(refOrbit[pair_type{{u, v}}] == refOrbit[pair_type{{x, y}}]));
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	// the dihedral group of the hexagon, transitive
+	check(6, {"(0 1 2 3 4 5)", "(1 5)(2 4)"});
+	// intransitive, with a fixed point and a non-self-paired orbital from the 3-cycle
+	check(10, {"(0 1 2 3 4 5)", "(1 5)(2 4)", "(6 7 8)"});
+	// a single transposition
+	check(5, {"(3 4)"});
+}
@@ -1,12 +1,20 @@
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/permutation/array.hpp>
 #include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/conj.hpp>
 #include <perm_group/permutation/io.hpp>
+#include <perm_group/permutation/materialize.hpp>
 #include <perm_group/permutation/mult.hpp>
 #include <perm_group/permutation/permutation.hpp>
+#include <perm_group/permutation/word.hpp>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <random>
+
 namespace pg = perm_group;
 
 BOOST_AUTO_TEST_CASE(test_main) {
@@ -19,4 +27,95 @@ BOOST_AUTO_TEST_CASE(test_main) {
 	auto res = pg::mult(pg::mult(p, p), p);
 	pRes = pg::copy_perm<perm_type>(pg::mult(p, res));
 	pg::write_permutation_cycles(std::cout << "Mult: ", pRes);
-}
\ No newline at end of file
+}
+
+template<typename Perm>
+void testMaterialize(std::size_t n) {
+	using value_type = typename pg::permutation_traits<Perm>::value_type;
+	std::mt19937 engine(n);
+	std::vector<Perm> ps;
+	for(int k = 0; k != 4; ++k) {
+		std::vector<value_type> images(n);
+		for(std::size_t i = 0; i != n; ++i) images[i] = i;
+		std::shuffle(images.begin(), images.end(), engine);
+		Perm p = pg::make_perm<Perm>(n);
+		for(std::size_t i = 0; i != n; ++i) pg::put(p, i, images[i]);
+		ps.push_back(std::move(p));
+	}
+	const auto check = [n](const auto &expr) {
+		std::vector<value_type> res(n);
+		Perm resOther = pg::make_perm<Perm>(n);
+		pg::materialize(expr, res);
+		pg::materialize(expr, resOther, n);
+		for(std::size_t i = 0; i != n; ++i) {
+			BOOST_REQUIRE_EQUAL(res[i], pg::get(expr, i));
+			BOOST_REQUIRE_EQUAL(pg::get(resOther, i), pg::get(expr, i));
+		}
+	};
+	check(pg::mult(ps[0], ps[1]));
+	check(pg::mult(pg::mult(ps[0], ps[1]), ps[2]));
+	check(pg::mult(ps[3], pg::mult(ps[0], pg::mult(ps[1], ps[2]))));
+	pg::permutation_word<const Perm*> word;
+	check(pg::mult(ps[0], word));
+	for(const auto &p : ps) word.push_back(&p);
+	check(pg::mult(ps[0], word));
+	// long enough to not be cache resident
+	for(int k = 0; k != 20; ++k) word.push_back(&ps[k % ps.size()]);
+	check(word);
+	check(pg::mult(word, pg::mult(ps[1], word)));
+}
+
+BOOST_AUTO_TEST_CASE(test_materialize) {
+	for(std::size_t n : {5, 64, 65, 3001, 20000}) {
+		testMaterialize<std::vector<int> >(n);
+		testMaterialize<std::vector<std::size_t> >(n);
+		testMaterialize<pg::array_permutation<unsigned int> >(n);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_conj) {
+	using perm_type = std::vector<int>;
+	std::mt19937 engine(42);
+	for(std::size_t n : {5, 100, 5000}) {
+		std::vector<perm_type> ps;
+		for(int k = 0; k != 3; ++k) {
+			perm_type p = pg::make_identity_perm<perm_type>(n);
+			std::shuffle(p.begin(), p.end(), engine);
+			ps.push_back(p);
+		}
+		const perm_type &p = ps[0], &a = ps[1], &b = ps[2];
+		const perm_type aInv = pg::make_inverse(a), bInv = pg::make_inverse(b);
+		const perm_type expectedConj = pg::copy_perm<perm_type>(pg::mult(pg::mult(aInv, p), a));
+		const perm_type expectedComm = pg::copy_perm<perm_type>(pg::mult(pg::mult(pg::mult(aInv, bInv), a), b));
+		perm_type res(n);
+		// a cached inverse, which must survive copies of the expression
+		const auto cCopy = [&]() {
+			const auto c = pg::conj(p, a);
+			auto copy = c;
+			return copy;
+		}();
+		pg::materialize(cCopy, res);
+		BOOST_REQUIRE(res == expectedConj);
+		for(std::size_t i = 0; i != n; ++i)
+			BOOST_REQUIRE_EQUAL(pg::get(cCopy, i), a[p[aInv[i]]]);
+		// a supplied inverse
+		pg::materialize(pg::conj(p, a, aInv), res);
+		BOOST_REQUIRE(res == expectedConj);
+		pg::materialize(pg::commutator(a, b), res);
+		BOOST_REQUIRE(res == expectedComm);
+		pg::materialize(pg::commutator(a, b, aInv, bInv), res);
+		BOOST_REQUIRE(res == expectedComm);
+		// nested in other expressions
+		pg::materialize(pg::mult(pg::conj(p, a), b), res);
+		BOOST_REQUIRE(res == pg::copy_perm<perm_type>(pg::mult(expectedConj, b)));
+
+		pg::raw_ptr_allocator<perm_type> alloc(n);
+		std::vector<perm_type*> conjugates;
+		const std::vector<const perm_type*> gens = {&p, &b};
+		pg::make_conjugates(alloc, gens.begin(), gens.end(), a, std::back_inserter(conjugates));
+		BOOST_REQUIRE_EQUAL(conjugates.size(), 2);
+		BOOST_REQUIRE(*conjugates[0] == expectedConj);
+		BOOST_REQUIRE(*conjugates[1] == pg::copy_perm<perm_type>(pg::mult(pg::mult(aInv, b), a)));
+		for(auto *ptr : conjugates) alloc.release(ptr);
+	}
+}
@@ -0,0 +1,82 @@
+#include <perm_group/orbit/action.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <set>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+
+template<typename Object, typename Action>
+void checkTree(const pg::action_orbit<Object> &o, const std::vector<const perm_type*> &gens, Action act) {
+	BOOST_REQUIRE_EQUAL(o.parent(0), o.npos);
+	BOOST_REQUIRE_EQUAL(o.label(0), o.npos);
+	for(std::size_t i = 0; i != o.size(); ++i) {
+		BOOST_REQUIRE_EQUAL(o.position(o[i]), i);
+		if(i != 0) {
+			BOOST_REQUIRE(o.parent(i) < i);
+			BOOST_REQUIRE(act(*gens[o.label(i)], o[o.parent(i)]) == o[i]);
+		}
+		Object x = o[0];
+		for(const std::size_t gen : o.labels_to(i))
+			x = act(*gens[gen], x);
+		BOOST_REQUIRE(x == o[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	const std::size_t n = 7;
+	perm_type swap = pg::make_identity_perm<perm_type>(n), cycle(n);
+	std::swap(swap[0], swap[1]);
+	for(std::size_t i = 0; i != n; ++i) cycle[i] = (i + 1) % n;
+	// S_n and C_n
+	const std::vector<const perm_type*> sym = {&swap, &cycle}, cyc = {&cycle};
+
+	{ // ordered pairs of distinct points, a single orbit under S_n
+		const auto o = pg::make_action_orbit(std::array<std::size_t, 2>{{0, 1}}, sym.begin(), sym.end(), pg::action_on_tuples());
+		BOOST_REQUIRE_EQUAL(o.size(), n * (n - 1));
+		BOOST_REQUIRE(!o.contains(std::array<std::size_t, 2>{{3, 3}}));
+		BOOST_REQUIRE_EQUAL(o.position(std::array<std::size_t, 2>{{3, 3}}), o.npos);
+		checkTree(o, sym, pg::action_on_tuples());
+		// the words map the pair pointwise
+		for(std::size_t i = 0; i != o.size(); ++i) {
+			const auto w = o.word_to(i, sym.begin());
+			BOOST_REQUIRE_EQUAL(pg::get(w, 0), o[i][0]);
+			BOOST_REQUIRE_EQUAL(pg::get(w, 1), o[i][1]);
+		}
+	}
+	{ // 3-subsets under C_n, n prime so all orbits have size n
+		const std::vector<std::size_t> s = {0, 1, 3};
+		const auto o = pg::make_action_orbit(s, cyc.begin(), cyc.end(), pg::action_on_sets());
+		BOOST_REQUIRE_EQUAL(o.size(), n);
+		for(const auto &x : o)
+			BOOST_REQUIRE(std::is_sorted(x.begin(), x.end()));
+		checkTree(o, cyc, pg::action_on_sets());
+		// and under S_n all of them
+		pg::action_orbit<std::vector<std::size_t> > all;
+		all.compute(s, sym.begin(), sym.end(), pg::action_on_sets());
+		BOOST_REQUIRE_EQUAL(all.size(), 35);
+		BOOST_REQUIRE(all.contains(std::vector<std::size_t>{4, 5, 6}));
+	}
+	{ // 2-colorings with 3 black points under S_n and C_n
+		const std::vector<char> c = {1, 1, 1, 0, 0, 0, 0};
+		const auto o = pg::make_action_orbit(c, sym.begin(), sym.end(), pg::action_on_colorings());
+		BOOST_REQUIRE_EQUAL(o.size(), 35);
+		std::set<std::vector<char> > unique(o.begin(), o.end());
+		BOOST_REQUIRE_EQUAL(unique.size(), o.size());
+		checkTree(o, sym, pg::action_on_colorings());
+		const auto oc = pg::make_action_orbit(c, cyc.begin(), cyc.end(), pg::action_on_colorings());
+		BOOST_REQUIRE_EQUAL(oc.size(), n);
+		// the color of point j in element i is the color of the preimage of j
+		for(std::size_t i = 0; i != o.size(); ++i) {
+			const auto w = o.word_to(i, sym.begin());
+			for(std::size_t j = 0; j != n; ++j)
+				BOOST_REQUIRE_EQUAL(o[i][pg::get(w, j)], c[j]);
+		}
+	}
+}
@@ -0,0 +1,61 @@
+#include <perm_group/orbit/bidirectional.hpp>
+#include <perm_group/orbit/partition.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/materialize.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	const std::size_t n = 500;
+	std::mt19937 engine(42);
+	// a few large orbits and fixed points
+	std::vector<perm_type> gens;
+	for(std::size_t i = 0; i != 3; ++i) {
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::shuffle(p.begin(), p.begin() + 200, engine);
+		std::shuffle(p.begin() + 250, p.begin() + 450, engine);
+		gens.push_back(p);
+	}
+	// and a long cycle, so some orbits are only connected through it
+	perm_type cycle = pg::make_identity_perm<perm_type>(n);
+	for(std::size_t i = 460; i != 499; ++i) cycle[i] = i + 1;
+	cycle[499] = 460;
+	gens.push_back(cycle);
+	std::vector<const perm_type*> ptrs;
+	for(const auto &p : gens) ptrs.push_back(&p);
+	pg::orbit_partition<std::size_t> partition(n);
+	for(const auto &p : gens) partition.add_generator(p);
+
+	std::vector<perm_type> inverses;
+	for(const auto &p : gens) {
+		inverses.emplace_back(n);
+		for(std::size_t i = 0; i != n; ++i) inverses.back()[p[i]] = i;
+	}
+	std::vector<const perm_type*> invPtrs;
+	for(const auto &p : inverses) invPtrs.push_back(&p);
+
+	std::uniform_int_distribution<std::size_t> dist(0, n - 1);
+	for(std::size_t round = 0; round != 2000; ++round) {
+		const std::size_t u = dist(engine);
+		// bias towards pairs in the same orbit
+		const std::size_t v = round % 2 == 0 ? dist(engine) : (round % 4 == 1 ? (u + 1) % n : u);
+		const bool same = partition.same_orbit(u, v);
+		BOOST_REQUIRE_EQUAL(pg::same_orbit(u, v, ptrs.begin(), ptrs.end()), same);
+		BOOST_REQUIRE_EQUAL(pg::same_orbit(u, v, ptrs.begin(), ptrs.end(), invPtrs.begin()), same);
+		const auto word = pg::find_element_mapping(u, v, ptrs.begin(), ptrs.end());
+		BOOST_REQUIRE_EQUAL(bool(word), same);
+		if(!word) continue;
+		BOOST_REQUIRE_EQUAL(pg::get(*word, u), v);
+		perm_type p(n);
+		pg::materialize(*word, p);
+		BOOST_REQUIRE_EQUAL(p[u], v);
+	}
+}
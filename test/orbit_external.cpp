@@ -0,0 +1,104 @@
+#include <perm_group/orbit.hpp>
+#include <perm_group/orbit/external.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <random>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+using pair_type = std::array<std::size_t, 2>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	char dirTemplate[] = "/tmp/perm_group_orbit_external_XXXXXX";
+	BOOST_REQUIRE(mkdtemp(dirTemplate));
+	pg::external_orbit_options opts;
+	opts.directory = dirTemplate;
+	// small buffers and fan-in, to get many runs merged in several passes
+	opts.memory_limit = 64 * sizeof(pair_type);
+	opts.max_merge_fan_in = 2;
+
+	const std::size_t n = 30;
+	std::mt19937 engine(42);
+	std::vector<perm_type> gens;
+	for(std::size_t i = 0; i != 2; ++i) {
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::shuffle(p.begin(), p.begin() + 20, engine);
+		gens.push_back(p);
+	}
+	std::vector<const perm_type*> ptrs;
+	for(const auto &p : gens) ptrs.push_back(&p);
+
+	const std::string dir = dirTemplate;
+	{ // points, compared to the in-memory orbit
+		pg::external_orbit<std::size_t> o(opts);
+		BOOST_REQUIRE(!o.resumed());
+		for(std::size_t w : {0, 25}) {
+			o.start(w);
+			o.run(ptrs.begin(), ptrs.end(), pg::action_on_points());
+			BOOST_REQUIRE(o.done());
+			std::vector<std::size_t> ref, res;
+			pg::orbit(w, ptrs.begin(), ptrs.end(), pg::make_orbit_callback_output_iterator(std::back_inserter(ref)));
+			std::sort(ref.begin(), ref.end());
+			o.for_each([&](std::size_t u) {
+				res.push_back(u);
+			});
+			BOOST_REQUIRE_EQUAL(o.size(), ref.size());
+			BOOST_REQUIRE(res == ref);
+		}
+	}
+	{ // the checkpoint of the point orbit is rejected for pairs
+		BOOST_REQUIRE_THROW(pg::external_orbit<pair_type>{opts}, pg::io_error);
+		const std::string level = std::to_string(pg::external_orbit<std::size_t>(opts).level());
+		BOOST_REQUIRE_EQUAL(std::remove((dir + "/visited_" + level).c_str()), 0);
+		BOOST_REQUIRE_EQUAL(std::remove((dir + "/frontier_" + level).c_str()), 0);
+		BOOST_REQUIRE_EQUAL(std::remove((dir + "/state").c_str()), 0);
+	}
+	{ // ordered pairs, compared to action_orbit, with a resume in the middle
+		const pair_type w = {{0, 1}};
+		auto ref = pg::make_action_orbit(w, ptrs.begin(), ptrs.end(), pg::action_on_tuples());
+		std::size_t sizeAfterTwo;
+		{
+			pg::external_orbit<pair_type> o(opts);
+			BOOST_REQUIRE(!o.resumed());
+			o.start(w);
+			BOOST_REQUIRE(o.step(ptrs.begin(), ptrs.end(), pg::action_on_tuples()));
+			BOOST_REQUIRE(o.step(ptrs.begin(), ptrs.end(), pg::action_on_tuples()));
+			BOOST_REQUIRE_EQUAL(o.level(), 2);
+			sizeAfterTwo = o.size();
+			o.for_each_in_frontier([&](const pair_type &x) {
+				BOOST_REQUIRE(ref.contains(x));
+			});
+		}
+		pg::external_orbit<pair_type> o(opts);
+		BOOST_REQUIRE(o.resumed());
+		BOOST_REQUIRE_EQUAL(o.level(), 2);
+		BOOST_REQUIRE_EQUAL(o.size(), sizeAfterTwo);
+		o.run(ptrs.begin(), ptrs.end(), pg::action_on_tuples());
+		BOOST_REQUIRE_EQUAL(o.size(), ref.size());
+		std::size_t count = 0;
+		pair_type prev;
+		o.for_each([&](const pair_type &x) {
+			BOOST_REQUIRE(ref.contains(x));
+			if(count != 0) BOOST_REQUIRE(prev < x);
+			prev = x;
+			++count;
+		});
+		BOOST_REQUIRE_EQUAL(count, ref.size());
+	}
+	// clean up, only the last level and the checkpoint are left
+	pg::external_orbit<pair_type> o(opts);
+	const std::string level = std::to_string(o.level());
+	BOOST_REQUIRE_EQUAL(std::remove((dir + "/visited_" + level).c_str()), 0);
+	BOOST_REQUIRE_EQUAL(std::remove((dir + "/frontier_" + level).c_str()), 0);
+	BOOST_REQUIRE_EQUAL(std::remove((dir + "/state").c_str()), 0);
+	BOOST_REQUIRE_EQUAL(rmdir(dirTemplate), 0);
+}
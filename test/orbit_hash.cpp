@@ -0,0 +1,74 @@
+#include <perm_group/orbit.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+
+template<template<typename> class InOrbitHandlerT>
+void testOrbits(const std::vector<const perm_type*> &ptrs, std::size_t n) {
+	const auto nop = [](auto&&...) {
+	};
+	pg::Orbit<std::size_t, InOrbitHandlerT> ws(n, 0);
+	for(std::size_t round = 0; round != 2; ++round) {
+		for(std::size_t w = 0; w != n; ++w) {
+			std::vector<std::size_t> ref, res;
+			pg::orbit(w, ptrs.begin(), ptrs.end(), pg::make_orbit_callback_output_iterator(std::back_inserter(ref)));
+			pg::orbit(w, ptrs.begin(), ptrs.end(), ws, pg::make_orbit_callback_output_iterator(std::back_inserter(res)), nop);
+			BOOST_REQUIRE(ref == res);
+			for(std::size_t i = 0; i != ref.size(); ++i)
+				BOOST_REQUIRE_EQUAL(ws.position(ref[i]), i);
+			for(std::size_t u = 0; u != n; ++u)
+				BOOST_REQUIRE_EQUAL(ws.isInOrbit(u), std::find(ref.begin(), ref.end(), u) != ref.end());
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::InOrbitHandler<pg::InOrbitHandlerHash>));
+	BOOST_CONCEPT_ASSERT((pg::InOrbitHandler<pg::InOrbitHandlerAdaptive>));
+	const std::size_t n = 400;
+	std::mt19937 engine(42);
+	// orbits of very different sizes, so the adaptive handler switches in the middle
+	std::vector<perm_type> gens;
+	for(std::size_t i = 0; i != 3; ++i) {
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::shuffle(p.begin(), p.begin() + 5, engine);
+		std::shuffle(p.begin() + 10, p.begin() + 30, engine);
+		std::shuffle(p.begin() + 100, p.begin() + 160, engine);
+		gens.push_back(p);
+	}
+	std::vector<const perm_type*> ptrs;
+	for(const auto &p : gens) ptrs.push_back(&p);
+	testOrbits<pg::InOrbitHandlerHash>(ptrs, n);
+	testOrbits<pg::InOrbitHandlerAdaptive>(ptrs, n);
+
+	// a chain with the adaptive handler
+	using alloc = pg::raw_ptr_allocator<perm_type>;
+	using system = pg::generating_system<pg::transversal_explicit<alloc, pg::InOrbitHandlerAdaptive> >;
+	using system_ref = pg::generating_system<pg::transversal_explicit<alloc> >;
+	system g{alloc(n)};
+	system_ref gRef{alloc(n)};
+	for(const auto &p : gens) {
+		g.add_generator(p);
+		gRef.add_generator(p);
+	}
+	std::vector<perm_type> candidates(gens);
+	candidates.push_back(pg::make_identity_perm<perm_type>(n));
+	std::swap(candidates.back()[0], candidates.back()[50]);
+	candidates.push_back(pg::make_identity_perm<perm_type>(n));
+	std::swap(candidates.back()[0], candidates.back()[1]);
+	for(const auto &p : candidates)
+		BOOST_REQUIRE_EQUAL(g.is_member(p), gRef.is_member(p));
+	BOOST_REQUIRE(!g.is_member(candidates[gens.size()]));
+}
@@ -0,0 +1,66 @@
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generated.hpp>
+#include <perm_group/orbit.hpp>
+#include <perm_group/orbit/image_table.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <tuple>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+using Record = std::tuple<std::size_t, std::size_t, std::size_t>; // from, img, generator
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	const std::size_t n = 100;
+	std::mt19937 engine(42);
+	pg::generated_group<pg::raw_ptr_allocator<perm_type> > g(n);
+	pg::generator_image_table<std::size_t> table(n);
+	// incrementally extended orbits of a few points, with and without the table
+	std::vector<pg::Orbit<std::size_t> > plain, tabled;
+	for(std::size_t w :{0, 42, 99}) {
+		plain.emplace_back(n, w);
+		tabled.emplace_back(n, w);
+	}
+	for(std::size_t round = 0; round != 10; ++round) {
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::shuffle(p.begin() + round * 5, p.begin() + round * 5 + 10, engine);
+		const auto lastOldIndex = g.generator_ptrs().size();
+		g.add_generator(p, std::ref(table));
+		const auto gens = g.generator_ptrs();
+		BOOST_REQUIRE_EQUAL(table.num_generators(), gens.size());
+		for(std::size_t u = 0; u != n; ++u)
+			for(std::size_t i = 0; i != gens.size(); ++i)
+				BOOST_REQUIRE_EQUAL(table.image(u, i), (*gens[i])[u]);
+		for(std::size_t o = 0; o != plain.size(); ++o) {
+			std::vector<Record> ref, res;
+			const auto first = gens.begin(), lastOld = first + lastOldIndex, last = gens.end();
+			const bool refDone = plain[o].update(first, lastOld, last, [&](auto u, auto img, auto it) {
+				ref.emplace_back(u, img, it - first);
+			}, [&](auto u, auto img, auto it) {
+				ref.emplace_back(u, img, it - first + n);
+			});
+			const bool resDone = tabled[o].update(table, first, lastOld, last, [&](auto u, auto img, auto it) {
+				res.emplace_back(u, img, it - first);
+			}, [&](auto u, auto img, auto it) {
+				res.emplace_back(u, img, it - first + n);
+			});
+			BOOST_CHECK_EQUAL(refDone, resDone);
+			BOOST_CHECK(ref == res);
+			BOOST_CHECK(std::equal(plain[o].begin(), plain[o].end(), tabled[o].begin(), tabled[o].end()));
+		}
+	}
+	// a table out of sync with the generators is rebuilt
+	pg::generator_image_table<std::size_t> late(n);
+	const auto gens = g.generator_ptrs();
+	late(gens.begin(), gens.end() - 1, gens.end());
+	BOOST_CHECK_EQUAL(late.num_generators(), gens.size());
+	BOOST_CHECK_EQUAL(late.image(7, gens.size() - 1), (*gens[gens.size() - 1])[7]);
+}
@@ -0,0 +1,68 @@
+#include <perm_group/orbit.hpp>
+#include <perm_group/orbit/parallel.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+using Record = std::tuple<int, int, std::size_t>; // from, img, generator
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	const std::size_t n = 100000;
+	std::mt19937 engine(42);
+	// products of many short cycles, so the orbits have many BFS levels,
+	// and the last points are fixed to get more than one orbit
+	std::vector<perm_type> gens;
+	for(std::size_t i = 0; i != 3; ++i) {
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::shuffle(p.begin(), p.begin() + 3 * n / 4, engine);
+		gens.push_back(p);
+	}
+	std::vector<const perm_type*> ptrs;
+	for(const auto &p : gens) ptrs.push_back(&p);
+
+	for(const int w :{0, int(n - 1)}) {
+		std::vector<Record> ref;
+		pg::orbit(w, ptrs.begin(), ptrs.end(), n, [&](int u, int img, auto it) {
+			ref.emplace_back(u, img, it - ptrs.begin());
+		}, [](auto&&...) {
+		});
+		for(const std::size_t threads :{1, 4}) {
+			pg::parallel_orbit_options opts;
+			opts.num_threads = threads;
+			opts.min_parallel_frontier = 1;
+			// deterministic gives the same order and parents as the sequential one
+			opts.deterministic = true;
+			std::vector<Record> det;
+			const auto orbitDet = pg::parallel_orbit(w, ptrs.begin(), ptrs.end(), n, opts, [&](int u, int img, auto it) {
+				det.emplace_back(u, img, it - ptrs.begin());
+			});
+			BOOST_REQUIRE_EQUAL(det.size(), ref.size());
+			BOOST_CHECK(det == ref);
+			BOOST_CHECK_EQUAL(orbitDet.size(), ref.size());
+			// otherwise the same set, and each parent maps to its image
+			opts.deterministic = false;
+			std::vector<Record> any;
+			auto orbitAny = pg::parallel_orbit(w, ptrs.begin(), ptrs.end(), n, opts, [&](int u, int img, auto it) {
+				any.emplace_back(u, img, it - ptrs.begin());
+			});
+			BOOST_REQUIRE_EQUAL(any.size(), ref.size());
+			for(std::size_t i = 1; i != any.size(); ++i) {
+				const auto &r = any[i];
+				BOOST_CHECK_EQUAL(gens[std::get<2>(r)][std::get<0>(r)], std::get<1>(r));
+			}
+			auto refOrbit = pg::parallel_orbit(w, ptrs.begin(), ptrs.end(), n, pg::parallel_orbit_options());
+			std::sort(orbitAny.begin(), orbitAny.end());
+			std::sort(refOrbit.begin(), refOrbit.end());
+			BOOST_CHECK(orbitAny == refOrbit);
+		}
+	}
+}
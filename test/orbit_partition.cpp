@@ -0,0 +1,61 @@
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generated.hpp>
+#include <perm_group/orbit.hpp>
+#include <perm_group/orbit/partition.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	const std::size_t n = 200;
+	std::mt19937 engine(42);
+	pg::generated_group<pg::raw_ptr_allocator<perm_type> > g(n);
+	pg::orbit_partition<> partition(n);
+	BOOST_CHECK_EQUAL(partition.num_orbits(), n);
+	for(std::size_t round = 0; round != 6; ++round) {
+		// a random permutation on a random subset of the points
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		std::vector<std::size_t> points(n);
+		std::iota(points.begin(), points.end(), 0);
+		std::shuffle(points.begin(), points.end(), engine);
+		points.resize(10);
+		for(std::size_t i = 0; i != points.size(); ++i)
+			p[points[i]] = points[(i + 1) % points.size()];
+		g.add_generator(p, std::ref(partition));
+
+		// compare with the orbits computed one at a time
+		const auto gens = g.generator_ptrs();
+		std::vector<bool> seen(n);
+		std::size_t numOrbits = 0;
+		for(std::size_t w = 0; w != n; ++w) {
+			if(seen[w]) continue;
+			++numOrbits;
+			std::vector<std::size_t> orbit;
+			pg::orbit(w, gens.begin(), gens.end(), pg::make_orbit_callback_output_iterator(std::back_inserter(orbit)));
+			for(const auto o : orbit) {
+				seen[o] = true;
+				BOOST_CHECK(partition.same_orbit(w, o));
+				BOOST_CHECK_EQUAL(partition.representative(o), w);
+				BOOST_CHECK_EQUAL(partition.orbit_size(o), orbit.size());
+			}
+		}
+		BOOST_CHECK_EQUAL(partition.num_orbits(), numOrbits);
+		const auto orbits = partition.orbits();
+		BOOST_CHECK_EQUAL(orbits.size(), numOrbits);
+		for(const auto &o : orbits) {
+			BOOST_CHECK(std::is_sorted(o.begin(), o.end()));
+			BOOST_CHECK_EQUAL(partition.representative(o.back()), o.front());
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#include <perm_group/orbit.hpp>
+#include <perm_group/permutation/built_in.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<std::size_t>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::InOrbitHandler<pg::InOrbitHandlerEpoch>));
+	const std::size_t n = 300;
+	std::mt19937 engine(42);
+	// several orbits, from shuffling disjoint blocks
+	std::vector<perm_type> gens;
+	for(std::size_t i = 0; i != 3; ++i) {
+		perm_type p = pg::make_identity_perm<perm_type>(n);
+		for(std::size_t b = 0; b + 50 <= n; b += 50 + i)
+			std::shuffle(p.begin() + b, p.begin() + b + 40, engine);
+		gens.push_back(p);
+	}
+	std::vector<const perm_type*> ptrs;
+	for(const auto &p : gens) ptrs.push_back(&p);
+	const auto nop = [](auto&&...) {
+	};
+
+	pg::orbit_workspace<std::size_t> ws(n, 0);
+	for(std::size_t round = 0; round != 3; ++round) {
+		for(std::size_t w = 0; w != n; ++w) {
+			std::vector<std::size_t> ref, res;
+			pg::orbit(w, ptrs.begin(), ptrs.end(), pg::make_orbit_callback_output_iterator(std::back_inserter(ref)));
+			pg::orbit(w, ptrs.begin(), ptrs.end(), ws, pg::make_orbit_callback_output_iterator(std::back_inserter(res)), nop);
+			BOOST_REQUIRE(ref == res);
+			BOOST_REQUIRE(std::equal(ws.begin(), ws.end(), ref.begin(), ref.end()));
+			for(std::size_t i = 0; i != ref.size(); ++i)
+				BOOST_REQUIRE_EQUAL(ws.position(ref[i]), i);
+			for(std::size_t u = 0; u != n; ++u)
+				BOOST_REQUIRE_EQUAL(ws.isInOrbit(u), std::find(ref.begin(), ref.end(), u) != ref.end());
+		}
+	}
+}
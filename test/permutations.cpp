@@ -1,6 +1,7 @@
 #include <perm_group/permutation/array.hpp>
 #include <perm_group/permutation/built_in.hpp>
 #include <perm_group/permutation/io.hpp>
+#include <perm_group/permutation/sparse.hpp>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MAIN
@@ -70,4 +71,5 @@ BOOST_AUTO_TEST_CASE(test_main) {
 	Test<std::vector<value_type>, const std::vector<value_type>, true > ();
 	Test<pg::array_permutation<value_type>, const pg::array_permutation<value_type>, false>();
 	Test<std::array<value_type, 42>, const std::array<value_type, 42>, true>();
+	Test<pg::sparse_permutation<value_type>, const pg::sparse_permutation<value_type>, true>();
 }
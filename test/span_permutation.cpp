@@ -0,0 +1,70 @@
+#include <perm_group/orbit.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/contiguous.hpp>
+#include <perm_group/permutation/span.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace pg = perm_group;
+
+using perm_type = std::vector<int>;
+using span_type = pg::span_permutation<int>;
+
+BOOST_AUTO_TEST_CASE(test_main) {
+	BOOST_CONCEPT_ASSERT((pg::DegreeAwarePermutation<span_type>));
+	static_assert(pg::has_contiguous_images<const span_type>::value, "");
+	const std::size_t n = 30, numGens = 3, numQueries = 100;
+	std::mt19937 engine(42);
+	// all generators and queries live in one big buffer, one row each
+	std::vector<int> buffer((numGens + numQueries) * n);
+	for(std::size_t r = 0; r != numGens + numQueries; ++r) {
+		int *row = buffer.data() + r * n;
+		std::iota(row, row + n, 0);
+		// only move the first half, so not every query is a member
+		std::shuffle(row, row + (r < numGens ? n / 2 : n), engine);
+	}
+	using system = pg::generating_system<pg::transversal_explicit<pg::raw_ptr_allocator<perm_type> > >;
+	system g(n), gRef(n);
+	std::vector<span_type> gens;
+	for(std::size_t r = 0; r != numGens; ++r) {
+		gens.push_back(pg::make_span_permutation(buffer.data() + r * n, n));
+		g.add_generator(gens.back());
+		gRef.add_generator(perm_type(buffer.begin() + r * n, buffer.begin() + (r + 1) * n));
+	}
+	BOOST_REQUIRE(g.generators().size() == gRef.generators().size());
+	for(std::size_t r = 0; r != numQueries; ++r) {
+		const span_type q(buffer.data() + (numGens + r) * n, n);
+		BOOST_REQUIRE_EQUAL(g.is_member(q), gRef.is_member(pg::copy_perm<perm_type>(q)));
+	}
+	for(std::size_t r = 0; r != numGens; ++r)
+		BOOST_REQUIRE(g.is_member(gens[r]));
+
+	// orbits directly from the buffer
+	std::vector<const span_type*> genPtrs;
+	for(const auto &s : gens) genPtrs.push_back(&s);
+	for(std::size_t w = 0; w != n; ++w) {
+		std::vector<int> orbit, orbitRef;
+		pg::orbit(w, genPtrs.begin(), genPtrs.end(), [&orbit](auto, auto o, auto) {
+			orbit.push_back(o);
+		});
+		pg::orbit(w, gRef, pg::make_orbit_callback_output_iterator(std::back_inserter(orbitRef)));
+		std::sort(orbit.begin(), orbit.end());
+		std::sort(orbitRef.begin(), orbitRef.end());
+		BOOST_REQUIRE(orbit == orbitRef);
+	}
+
+	// and as the source of an expression
+	perm_type out(n);
+	pg::materialize(pg::mult(gens[0], gens[1]), out);
+	for(std::size_t i = 0; i != n; ++i)
+		BOOST_REQUIRE_EQUAL(out[i], buffer[n + buffer[i]]);
+}
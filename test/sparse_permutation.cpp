@@ -0,0 +1,119 @@
+#include <perm_group/orbit.hpp>
+#include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/permutation/built_in.hpp>
+#include <perm_group/permutation/io.hpp>
+#include <perm_group/permutation/sparse.hpp>
+#include <perm_group/transversal/explicit.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace pg = perm_group;
+
+using value_type = int;
+using sparse_perm = pg::sparse_permutation<value_type>;
+using dense_perm = std::vector<value_type>;
+
+// a random permutation of degree n moving at most k elements
+dense_perm makeRandomSparse(std::mt19937 &engine, std::size_t n, std::size_t k) {
+	dense_perm p = pg::make_identity_perm<dense_perm>(n);
+	std::vector<value_type> moved(n);
+	for(std::size_t i = 0; i != n; ++i) moved[i] = i;
+	std::shuffle(moved.begin(), moved.end(), engine);
+	moved.resize(k);
+	std::vector<value_type> images = moved;
+	std::shuffle(images.begin(), images.end(), engine);
+	for(std::size_t i = 0; i != k; ++i) p[moved[i]] = images[i];
+	return p;
+}
+
+template<typename PermA, typename PermB>
+void checkEqual(const PermA &a, const PermB &b, std::size_t n) {
+	for(std::size_t i = 0; i != n; ++i)
+		BOOST_REQUIRE_EQUAL(pg::get(a, i), pg::get(b, i));
+}
+
+BOOST_AUTO_TEST_CASE(test_basic) {
+	BOOST_CONCEPT_ASSERT((pg::MutablePermutation<sparse_perm>));
+	BOOST_CONCEPT_ASSERT((pg::DegreeAwarePermutation<sparse_perm>));
+	static_assert(pg::has_support<sparse_perm>::value, "");
+	static_assert(!pg::has_support<dense_perm>::value, "");
+	const std::size_t n = 10000;
+	std::mt19937 engine(42);
+	for(int round = 0; round != 20; ++round) {
+		const dense_perm a = makeRandomSparse(engine, n, 50);
+		const dense_perm b = makeRandomSparse(engine, n, 70);
+		const sparse_perm aS = pg::copy_perm<sparse_perm>(a);
+		const sparse_perm bS = pg::copy_perm<sparse_perm>(b);
+		checkEqual(aS, a, n);
+		BOOST_REQUIRE(aS.support_().size() <= 50);
+		BOOST_REQUIRE(pg::first_moved(aS, n) == pg::first_moved(a, n));
+		BOOST_REQUIRE(aS == pg::copy_perm<sparse_perm>(a));
+		BOOST_REQUIRE(aS != bS);
+
+		checkEqual(pg::make_inverse(aS), pg::make_inverse(a), n);
+		sparse_perm id(n);
+		pg::materialize(pg::mult(aS, pg::make_inverse(aS)), id);
+		BOOST_REQUIRE(id.support_().empty());
+		BOOST_REQUIRE(id == pg::make_identity_perm<sparse_perm>(n));
+		BOOST_REQUIRE(pg::is_identity(pg::mult(aS, pg::make_inverse(aS)), n));
+
+		sparse_perm ab(n);
+		pg::materialize(pg::mult(aS, bS), ab);
+		checkEqual(ab, pg::mult(a, b), n);
+		dense_perm abDense(n);
+		pg::materialize(pg::mult(aS, bS), abDense);
+		checkEqual(abDense, pg::mult(a, b), n);
+		pg::materialize(pg::mult(a, b), ab);
+		checkEqual(ab, pg::mult(a, b), n);
+		// more factors, with their supports merged
+		sparse_perm abab(n);
+		pg::materialize(pg::mult(pg::mult(aS, bS), pg::mult(aS, bS)), abab);
+		BOOST_REQUIRE(std::is_sorted(abab.support_().begin(), abab.support_().end()));
+		checkEqual(abab, pg::mult(pg::mult(a, b), pg::mult(a, b)), n);
+	}
+	sparse_perm p(5);
+	pg::read_permutation_cycles("(1 3)(2 4)", p);
+	pg::put(p, 1, 1);
+	pg::put(p, 3, 3);
+	pg::write_permutation_cycles(std::cout << "Sparse: ", p) << std::endl;
+	BOOST_REQUIRE_EQUAL(p.support_().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_group) {
+	const std::size_t n = 2000;
+	std::mt19937 engine(1337);
+	using sparse_system = pg::generating_system<pg::transversal_explicit<pg::raw_ptr_allocator<sparse_perm> > >;
+	using dense_system = pg::generating_system<pg::transversal_explicit<pg::raw_ptr_allocator<dense_perm> > >;
+	for(int round = 0; round != 5; ++round) {
+		sparse_system gS(n);
+		dense_system g(n);
+		std::vector<dense_perm> gens;
+		for(int i = 0; i != 3; ++i) {
+			gens.push_back(makeRandomSparse(engine, n, 6));
+			gS.add_generator(pg::copy_perm<sparse_perm>(gens.back()));
+			g.add_generator(gens.back());
+		}
+		BOOST_REQUIRE_EQUAL(gS.generators().size(), g.generators().size());
+		for(int i = 0; i != 50; ++i) {
+			dense_perm member = pg::make_identity_perm<dense_perm>(n);
+			for(int j = 0; j != 10; ++j)
+				member = pg::copy_perm<dense_perm>(pg::mult(member, gens[engine() % gens.size()]));
+			const dense_perm other = makeRandomSparse(engine, n, 6);
+			BOOST_REQUIRE(g.is_member(member));
+			BOOST_REQUIRE(gS.is_member(pg::copy_perm<sparse_perm>(member)));
+			BOOST_REQUIRE_EQUAL(g.is_member(other), gS.is_member(pg::copy_perm<sparse_perm>(other)));
+		}
+		for(std::size_t w = 0; w != n; ++w) {
+			std::vector<value_type> orbit, orbitS;
+			pg::orbit(w, g, pg::make_orbit_callback_output_iterator(std::back_inserter(orbit)));
+			pg::orbit(w, gS, pg::make_orbit_callback_output_iterator(std::back_inserter(orbitS)));
+			BOOST_REQUIRE(orbit == orbitS);
+		}
+	}
+}
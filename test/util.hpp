@@ -1,9 +1,15 @@
 #ifndef PERM_GROUP_UTIL_HPP
 #define PERM_GROUP_UTIL_HPP
 
+#include <perm_group/allocator/arena.hpp>
+#include <perm_group/allocator/concurrent_pooled.hpp>
+#include <perm_group/allocator/interning.hpp>
 #include <perm_group/allocator/shared_ptr.hpp>
 #include <perm_group/allocator/pooled.hpp>
 #include <perm_group/allocator/raw_ptr.hpp>
+#include <perm_group/allocator/ref_counted.hpp>
+#include <perm_group/group/generating_system.hpp>
+#include <perm_group/transversal/explicit.hpp>
 
 #include <boost/program_options.hpp>
 
@@ -37,10 +43,38 @@ template<typename perm_type, typename F>
 void runForEachAllocator(F f) {
 	f(Wrapper<pg::shared_ptr_allocator<perm_type> >());
 	f(Wrapper<pg::raw_ptr_allocator<perm_type> >());
+	f(Wrapper<pg::ref_counted_allocator<perm_type> >());
 	f(Wrapper<pg::pooled_allocator<pg::raw_ptr_allocator<perm_type> > >{[](auto n) {
 			pg::raw_ptr_allocator<perm_type> inner(n);
 			return pg::pooled_allocator<pg::raw_ptr_allocator<perm_type> >(n, inner);
 		}});
+	f(Wrapper<pg::concurrent_pooled_allocator<pg::raw_ptr_allocator<perm_type> > >{[](auto n) {
+			pg::raw_ptr_allocator<perm_type> inner(n);
+			return pg::concurrent_pooled_allocator<pg::raw_ptr_allocator<perm_type> >(n, inner);
+		}});
+	f(Wrapper<pg::interning_allocator<pg::raw_ptr_allocator<perm_type> > >{[](auto n) {
+			return pg::interning_allocator<pg::raw_ptr_allocator<perm_type> >(pg::raw_ptr_allocator<perm_type>(n));
+		}});
+	f(Wrapper<pg::arena_allocator<typename perm_type::value_type> >());
+}
+
+// Whether a group on permutations from alloc, generated by gens,
+// agrees on the membership of each of elems with one on separately allocated permutations.
+// For allocators with their own setup, which are not in runForEachAllocator.
+
+template<typename Alloc, typename Perm>
+bool sameMembership(const Alloc &alloc, const std::vector<Perm> &gens, const std::vector<Perm> &elems) {
+	using system = pg::generating_system<pg::transversal_explicit<Alloc> >;
+	using system_ref = pg::generating_system<pg::transversal_explicit<pg::raw_ptr_allocator<Perm> > >;
+	system g(alloc);
+	system_ref gRef(alloc.degree());
+	for(const auto &gen : gens) {
+		g.add_generator(gen);
+		gRef.add_generator(gen);
+	}
+	for(const auto &p : elems)
+		if(g.is_member(p) != gRef.is_member(p)) return false;
+	return true;
 }
 
 struct TestProgram {